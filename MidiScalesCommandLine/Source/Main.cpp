@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+    This file contains the basic startup code for a JUCE application.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OfflineMidiRenderer.h"
+#include "MidiBenchmarks.h"
+#include "Tests/TestHelpers.h"
+
+#include <fstream>
+
+//==============================================================================
+// Lower case with spaces, dashes and slashes removed so "natural-minor" matches "Natural Minor"
+static juce::String NormaliseName(const juce::String& name)
+{
+    return name.toLowerCase().removeCharacters(" -_/");
+}
+
+static Scales::Type::eType ParseScaleType(const juce::String& text)
+{
+    const ScaleLibrary& scaleLibrary = ScaleLibrary::GetInstance();
+    
+    for(int i = 1; i < scaleLibrary.GetNumScales(); i++)
+    {
+        if(!scaleLibrary.IsValidScale(i))
+            continue;
+        
+        Scales::Type::eType scaleType = (Scales::Type::eType) i;
+        const juce::String scaleName = NormaliseName(Helpers::GetScaleTypeString(scaleType));
+        
+        if(scaleName == NormaliseName(text) || scaleName.upToFirstOccurrenceOf("/", false, false) == NormaliseName(text))
+            return scaleType;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown scale: " + text + " (see --list)");
+    return Scales::Type::Invalid;
+}
+
+static Chords::Type::eType ParseChordType(const juce::String& text)
+{
+    const ScaleLibrary& scaleLibrary = ScaleLibrary::GetInstance();
+    
+    for(int i = 1; i < scaleLibrary.GetNumChords(); i++)
+    {
+        Chords::Type::eType chordType = (Chords::Type::eType) i;
+        if(scaleLibrary.IsValidChord(i) && NormaliseName(Helpers::GetChordTypeString(chordType)) == NormaliseName(text))
+            return chordType;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown chord: " + text + " (see --list)");
+    return Chords::Type::Invalid;
+}
+
+static Quantize::Mode::eMode ParseQuantizeMode(const juce::String& text)
+{
+    for(int i = 0; i < Quantize::Mode::Total; i++)
+    {
+        Quantize::Mode::eMode quantizeMode = (Quantize::Mode::eMode) i;
+        if(NormaliseName(Helpers::GetQuantizeModeString(quantizeMode)) == NormaliseName(text))
+            return quantizeMode;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown quantize mode: " + text + " (off, nearest, up, down or degree)");
+    return Quantize::Mode::Off;
+}
+
+static Voicing::Mode::eMode ParseVoicingMode(const juce::String& text)
+{
+    for(int i = 0; i < Voicing::Mode::Total; i++)
+    {
+        Voicing::Mode::eMode voicingMode = (Voicing::Mode::eMode) i;
+        if(NormaliseName(Helpers::GetVoicingModeString(voicingMode)) == NormaliseName(text))
+            return voicingMode;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown voicing: " + text + " (root-position or voice-leading)");
+    return Voicing::Mode::RootPosition;
+}
+
+static Strum::Direction::eDirection ParseStrumDirection(const juce::String& text)
+{
+    for(int i = 0; i < Strum::Direction::Total; i++)
+    {
+        Strum::Direction::eDirection strumDirection = (Strum::Direction::eDirection) i;
+        if(NormaliseName(Helpers::GetStrumDirectionString(strumDirection)) == NormaliseName(text))
+            return strumDirection;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown strum direction: " + text + " (up, down or alternate)");
+    return Strum::Direction::Up;
+}
+
+static Arpeggio::Pattern::ePattern ParseArpPattern(const juce::String& text)
+{
+    for(int i = 0; i < Arpeggio::Pattern::Total; i++)
+    {
+        Arpeggio::Pattern::ePattern arpPattern = (Arpeggio::Pattern::ePattern) i;
+        if(NormaliseName(Helpers::GetArpPatternString(arpPattern)) == NormaliseName(text))
+            return arpPattern;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown arpeggio pattern: " + text + " (up, down, up-down, random or as-played)");
+    return Arpeggio::Pattern::Up;
+}
+
+static Arpeggio::Rate::eRate ParseArpRate(const juce::String& text)
+{
+    for(int i = 0; i < Arpeggio::Rate::Total; i++)
+    {
+        Arpeggio::Rate::eRate arpRate = (Arpeggio::Rate::eRate) i;
+        if(NormaliseName(Helpers::GetArpRateString(arpRate)) == NormaliseName(text))
+            return arpRate;
+    }
+    
+    juce::ConsoleApplication::fail("Unknown arpeggio rate: " + text + " (1/4, 1/8, 1/8T, 1/16, 1/16T or 1/32)");
+    return Arpeggio::Rate::Sixteenth;
+}
+
+// Note name such as "C", "F#" or "Bb" to a pitch class
+static int ParseScaleNote(const juce::String& text)
+{
+    const int iNoteType = Helpers::GetNoteType(text.substring(0, 1).toUpperCase().toRawUTF8());
+    if(iNoteType < 0)
+        juce::ConsoleApplication::fail("Unknown scale root note: " + text);
+    
+    int iScaleNote = Helpers::GetNoteNumber((Notes::Type::eType) iNoteType);
+    for(auto accidental : text.substring(1))
+        iScaleNote += accidental == '#' ? 1 : (accidental == 'b' ? -1 : 0);
+    
+    return (iScaleNote + SCALES_OCTAVE_STEPS) % SCALES_OCTAVE_STEPS;
+}
+
+static void RenderCommand(const juce::ArgumentList& args)
+{
+    args.checkMinNumArguments(3);
+    
+    const juce::File inputFile = args[1].resolveAsExistingFile();
+    const juce::File outputFile = args[2].resolveAsFile();
+    
+    OfflineMidiRenderer::Settings settings;
+    
+    if(args.containsOption("--scale-root"))
+        settings.iScaleNote = ParseScaleNote(args.getValueForOption("--scale-root"));
+    if(args.containsOption("--scale"))
+        settings.scaleType = ParseScaleType(args.getValueForOption("--scale"));
+    if(args.containsOption("--chord"))
+        settings.chordType = ParseChordType(args.getValueForOption("--chord"));
+    if(args.containsOption("--quantize"))
+        settings.quantizeMode = ParseQuantizeMode(args.getValueForOption("--quantize"));
+    if(args.containsOption("--diatonic"))
+        settings.bDiatonicChords = true;
+    if(args.containsOption("--voicing"))
+        settings.voicingMode = ParseVoicingMode(args.getValueForOption("--voicing"));
+    if(args.containsOption("--register"))
+    {
+        // MIDI note numbers, "48-84"
+        const juce::String registerText = args.getValueForOption("--register");
+        settings.iVoicingLowNote = registerText.upToFirstOccurrenceOf("-", false, false).getIntValue();
+        settings.iVoicingHighNote = registerText.fromFirstOccurrenceOf("-", false, false).getIntValue();
+        
+        if(settings.iVoicingLowNote < 0 || settings.iVoicingHighNote >= SCALES_TOTAL_STEPS
+           || settings.iVoicingHighNote - settings.iVoicingLowNote < VOICING_MIN_REGISTER_STEPS)
+            juce::ConsoleApplication::fail("Invalid register: " + registerText + " (two MIDI notes at least an octave apart, such as 48-84)");
+    }
+    if(args.containsOption("--strum"))
+        settings.iStrumMs = juce::jlimit(0, STRUM_MAX_NOTE_MS, args.getValueForOption("--strum").getIntValue());
+    if(args.containsOption("--strum-direction"))
+        settings.strumDirection = ParseStrumDirection(args.getValueForOption("--strum-direction"));
+    if(args.containsOption("--strum-velocity"))
+        settings.iStrumVelocityCurve = juce::jlimit(-100, 100, args.getValueForOption("--strum-velocity").getIntValue());
+    if(args.containsOption("--humanize"))
+        settings.iHumanize = juce::jlimit(0, 100, args.getValueForOption("--humanize").getIntValue());
+    if(args.containsOption("--arp"))
+    {
+        settings.bArpeggiator = true;
+        settings.arpPattern = ParseArpPattern(args.getValueForOption("--arp"));
+    }
+    if(args.containsOption("--arp-rate"))
+        settings.arpRate = ParseArpRate(args.getValueForOption("--arp-rate"));
+    if(args.containsOption("--arp-gate"))
+        settings.iArpGate = juce::jlimit(1, 100, args.getValueForOption("--arp-gate").getIntValue());
+    if(args.containsOption("--mpe"))
+        settings.bMpe = true;
+    if(args.containsOption("--bpm"))
+        settings.dTempoBpm = juce::jlimit(1.0, ARPEGGIATOR_MAX_BPM, args.getValueForOption("--bpm").getDoubleValue());
+    if(args.containsOption("--block-size"))
+        settings.iBlockSize = juce::jlimit(1, 65536, args.getValueForOption("--block-size").getIntValue());
+    if(args.containsOption("--sample-rate"))
+        settings.dSampleRate = juce::jlimit(1000.0, 768000.0, args.getValueForOption("--sample-rate").getDoubleValue());
+    
+    OfflineMidiRenderer renderer(settings);
+    OfflineMidiRenderer::Result result;
+    juce::String errorMessage;
+    
+    if(!renderer.RenderFile(inputFile, outputFile, result, errorMessage))
+        juce::ConsoleApplication::fail(errorMessage);
+    
+    std::cout << "Rendered " << inputFile.getFileName() << " -> " << outputFile.getFileName() << std::endl
+              << "  Blocks:        " << result.iNumBlocks << " x " << settings.iBlockSize << " samples @ " << settings.dSampleRate << " Hz" << std::endl
+              << "  Input events:  " << result.iNumInputEvents << std::endl
+              << "  Output events: " << result.iNumOutputEvents << std::endl
+              << "  processBlock:  " << result.dProcessingSeconds * 1000.0 << " ms" << std::endl
+              << "  Throughput:    " << (juce::int64) result.GetInputEventsPerSecond() << " input events/s, "
+                                     << (juce::int64) result.GetOutputEventsPerSecond() << " output events/s" << std::endl
+              << "  Block stats:   " << result.blockStats.ToString() << std::endl;
+}
+
+static void BenchmarkCommand(const juce::ArgumentList& args)
+{
+    juce::int64 iMinEventsPerCase = 200000;
+    if(args.containsOption("--events"))
+        iMinEventsPerCase = juce::jmax((juce::int64) 1, args.getValueForOption("--events").getLargeIntValue());
+    
+    const auto results = MidiBenchmarks::RunAll(iMinEventsPerCase);
+    MidiBenchmarks::PrintTable(results, std::cout);
+    
+    if(args.containsOption("--csv"))
+    {
+        const juce::File csvFile = args.getFileForOption("--csv");
+        std::ofstream csvStream(csvFile.getFullPathName().toStdString());
+        
+        if(!csvStream)
+            juce::ConsoleApplication::fail("Couldn't write benchmark results: " + csvFile.getFullPathName());
+        
+        MidiBenchmarks::WriteCsv(results, csvStream);
+    }
+}
+
+static void TestCommand(const juce::ArgumentList&)
+{
+    juce::UnitTestRunner testRunner;
+    testRunner.setAssertOnFailure(false);
+    testRunner.runTestsInCategory(UNIT_TEST_CATEGORY);
+    
+    int iNumFailures = 0;
+    for(int i = 0; i < testRunner.getNumResults(); i++)
+        iNumFailures += testRunner.getResult(i)->failures;
+    
+    if(iNumFailures > 0)
+        juce::ConsoleApplication::fail(juce::String(iNumFailures) + " test(s) failed");
+}
+
+static void ListCommand(const juce::ArgumentList&)
+{
+    const ScaleLibrary& scaleLibrary = ScaleLibrary::GetInstance();
+    
+    std::cout << "Library: " << (scaleLibrary.IsBuiltIn() ? juce::String("built-in") : ScaleLibraryFormat::GetUserLibraryFile().getFullPathName()) << std::endl;
+    
+    std::cout << "Scales:" << std::endl;
+    for(int i = 1; i < scaleLibrary.GetNumScales(); i++)
+    {
+        if(scaleLibrary.IsValidScale(i))
+            std::cout << "  " << scaleLibrary.GetScaleName(i) << std::endl;
+    }
+    
+    std::cout << "Chords:" << std::endl;
+    for(int i = 1; i < scaleLibrary.GetNumChords(); i++)
+    {
+        if(scaleLibrary.IsValidChord(i))
+            std::cout << "  " << scaleLibrary.GetChordName(i) << std::endl;
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ConsoleApplication app;
+    
+    app.addHelpCommand("--help|-h", "MidiScalesCommandLine - runs the MidiScales processor without a host or audio device", true);
+    
+    app.addCommand({ "--render",
+                     "--render <input.mid> <output.mid> [--scale-root=C] [--scale=Major] [--chord=\"Major Triad\"] [--quantize=off|nearest|up|down|degree] [--diatonic] [--voicing=root-position|voice-leading] [--register=48-84] [--strum=0] [--strum-direction=up|down|alternate] [--strum-velocity=0] [--humanize=0] [--arp=up|down|up-down|random|as-played] [--arp-rate=1/16] [--arp-gate=50] [--bpm=120] [--mpe] [--block-size=512] [--sample-rate=44100]",
+                     "Streams a MIDI file through processBlock and writes the chord-expanded result",
+                     "Every track of the input is merged and fed to the processor in fixed size blocks. "
+                     "--quantize snaps notes outside the scale onto it instead of muting them. "
+                     "--diatonic stacks each chord from the scale's degrees, --chord then only sets the number of notes. "
+                     "--voicing=voice-leading picks the inversion and octave of each chord closest to the previous one, inside --register. "
+                     "--strum delays each chord note by that many ms after the previous one, --strum-velocity changes the last "
+                     "strummed note's velocity by that percentage and --humanize (percent) randomises note timing and velocity. "
+                     "--arp plays the held chords one note per --arp-rate step in that pattern, each note sounding for --arp-gate "
+                     "percent of a step, on a timeline at --bpm that starts with the file. "
+                     "--mpe gives every chord note its own MPE member channel and copies the pitch bend, pressure and timbre "
+                     "of the input channel that started the chord to them. "
+                     "The output is a single track MIDI file, followed by a throughput report and the processor's "
+                     "per-block cost (min/avg/percentiles/max against the block deadline).",
+                     RenderCommand });
+    
+    app.addCommand({ "--benchmark",
+                     "--benchmark [--events=200000] [--csv=results.csv]",
+                     "Runs the MIDI hot path microbenchmarks",
+                     "Times processBlock, PressedChord::GenerateMidi, IsNoteInScaleSafe and Helpers::GetChordSequence "
+                     "over synthetic event streams of several densities and block sizes. Reports ns/event, the 99.9th "
+                     "percentile block time, heap allocations in the timed code and a checksum of each case's results, optionally as CSV.",
+                     BenchmarkCommand });
+    
+    app.addCommand({ "--test",
+                     "--test",
+                     "Runs the unit tests",
+                     "Runs every juce::UnitTest in the " UNIT_TEST_CATEGORY " category and fails if any expectation fails.",
+                     TestCommand });
+    
+    app.addCommand({ "--list",
+                     "--list",
+                     "Lists the scale and chord names accepted by --render",
+                     {},
+                     ListCommand });
+    
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,373 @@
+/*
+  ==============================================================================
+
+    MidiBenchmarks.cpp
+    Created: 17 Oct 2026 3:06:12pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "MidiBenchmarks.h"
+#include "../../MidiScalesPlugin/Source/PluginProcessor.h"
+
+#include <iomanip>
+#include <vector>
+
+#define BENCHMARK_SAMPLE_RATE 44100.0
+#define BENCHMARK_RANDOM_SEED 0x5ca1e5
+#define BENCHMARK_MIN_BLOCKS 2000
+// Calls timed together as one block for the cases that don't have one
+#define BENCHMARK_CALLS_PER_BATCH 1024
+
+namespace MidiBenchmarks
+{
+    // Times blocks of work and summarises them into a Result
+    class BlockTimer
+    {
+    public:
+        BlockTimer(juce::int64 iNumBlocks)
+        {
+            m_blockSeconds.reserve((size_t) iNumBlocks);
+        }
+        
+        void Start()
+        {
+            m_iAllocationsAtStart = RealtimeAllocations::GetAllocationCount();
+            m_iStartTicks = juce::Time::getHighResolutionTicks();
+        }
+        
+        void Stop()
+        {
+            const juce::int64 iEndTicks = juce::Time::getHighResolutionTicks();
+            m_blockSeconds.push_back(juce::Time::highResolutionTicksToSeconds(iEndTicks - m_iStartTicks));
+            m_iAllocations += RealtimeAllocations::GetAllocationCount() - m_iAllocationsAtStart;
+        }
+        
+        Result GetResult(const juce::String& name, int iBlockSize, int iEventsPerBlock, juce::int64 iChecksum)
+        {
+            Result result;
+            result.name = name;
+            result.iBlockSize = iBlockSize;
+            result.iEventsPerBlock = iEventsPerBlock;
+            result.iNumBlocks = (juce::int64) m_blockSeconds.size();
+            result.iAllocations = m_iAllocations;
+            result.iChecksum = iChecksum;
+            
+            if(m_blockSeconds.empty())
+                return result;
+            
+            double dTotalSeconds = 0.0;
+            for(double dSeconds : m_blockSeconds)
+                dTotalSeconds += dSeconds;
+            
+            std::sort(m_blockSeconds.begin(), m_blockSeconds.end());
+            const size_t uP999Index = (size_t) std::ceil(0.999 * (double) m_blockSeconds.size()) - 1;
+            
+            result.dNanosPerEvent = dTotalSeconds * 1.0e9 / ((double) m_blockSeconds.size() * iEventsPerBlock);
+            result.dMeanBlockMicros = dTotalSeconds * 1.0e6 / (double) m_blockSeconds.size();
+            result.dP999BlockMicros = m_blockSeconds[uP999Index] * 1.0e6;
+            result.dMaxBlockMicros = m_blockSeconds.back() * 1.0e6;
+            
+            return result;
+        }
+        
+    private:
+        std::vector<double> m_blockSeconds;
+        juce::int64 m_iStartTicks = 0;
+        juce::int64 m_iAllocationsAtStart = 0;
+        juce::int64 m_iAllocations = 0;
+    };
+    
+    static juce::int64 GetNumBlocks(juce::int64 iMinEventsPerCase, int iEventsPerBlock)
+    {
+        return juce::jmax((juce::int64) BENCHMARK_MIN_BLOCKS, iMinEventsPerCase / iEventsPerBlock);
+    }
+    
+    // Note-on/note-off pairs spread evenly over the block, a mix of in and out of scale notes
+    static void FillSyntheticBlock(juce::MidiBuffer& midiBuffer, juce::Random& random, int iBlockSize, int iNumEvents, int& iHeldNote)
+    {
+        midiBuffer.clear();
+        
+        for(int i=0; i<iNumEvents; i++)
+        {
+            const int iSamplePosition = (int) (((juce::int64) i * iBlockSize) / iNumEvents);
+            
+            if(iHeldNote < 0)
+            {
+                iHeldNote = 36 + random.nextInt(48);
+                midiBuffer.addEvent(juce::MidiMessage::noteOn(1, iHeldNote, (juce::uint8) 100), iSamplePosition);
+            }
+            else
+            {
+                midiBuffer.addEvent(juce::MidiMessage::noteOff(1, iHeldNote, (juce::uint8) 0), iSamplePosition);
+                iHeldNote = -1;
+            }
+        }
+    }
+    
+    // bStrum: the longest strum with full humanize, so most notes are carried across blocks
+    static Result RunProcessBlock(int iBlockSize, int iEventsPerBlock, bool bStrum, juce::int64 iMinEventsPerCase)
+    {
+        MidiScalesPluginAudioProcessor processor;
+        processor.SetScaleSafe(0, Scales::Type::Major);
+        processor.m_ChordType.set(Chords::Type::MajorSeventh);
+        if(bStrum)
+        {
+            processor.m_iStrumMs.set(STRUM_MAX_NOTE_MS);
+            processor.m_StrumDirection.set(Strum::Direction::Alternate);
+            processor.m_iHumanize.set(100);
+        }
+        processor.setRateAndBufferSizeDetails(BENCHMARK_SAMPLE_RATE, iBlockSize);
+        processor.prepareToPlay(BENCHMARK_SAMPLE_RATE, iBlockSize);
+        
+        juce::AudioBuffer<float> audioBuffer(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()), iBlockSize);
+        // Kept alive across blocks and reserved up front like a host's buffer, so its storage is reused
+        juce::MidiBuffer midiBuffer;
+        midiBuffer.ensureSize(processor.GetMidiBufferBytes());
+        juce::Random random(BENCHMARK_RANDOM_SEED);
+        int iHeldNote = -1;
+        
+        const juce::int64 iNumBlocks = GetNumBlocks(iMinEventsPerCase, iEventsPerBlock);
+        BlockTimer timer(iNumBlocks);
+        juce::int64 iChecksum = 0;
+        
+        for(juce::int64 iBlock = 0; iBlock < iNumBlocks; iBlock++)
+        {
+            FillSyntheticBlock(midiBuffer, random, iBlockSize, iEventsPerBlock, iHeldNote);
+            
+            timer.Start();
+            processor.processBlock(audioBuffer, midiBuffer);
+            timer.Stop();
+            
+            iChecksum += midiBuffer.getNumEvents();
+        }
+        
+        processor.releaseResources();
+        
+        return timer.GetResult(bStrum ? "processBlock (strum)" : "processBlock", iBlockSize, iEventsPerBlock, iChecksum);
+    }
+    
+    static Result RunGenerateMidi(int iEventsPerBlock, juce::int64 iMinEventsPerCase)
+    {
+        PressedChord chord;
+        MidiNoteScheduler noteScheduler;
+        noteScheduler.Prepare((iEventsPerBlock + CHORD_MAX_VOICES) * CHORD_MAX_NOTES);
+        // Attached and drained every block, as if the editor were open
+        KeyboardStateFifo keyboardStateFifo;
+        juce::MidiKeyboardState keyboardState;
+        keyboardStateFifo.Attach();
+        juce::MidiBuffer processedMidi;
+        processedMidi.ensureSize((size_t) iEventsPerBlock * CHORD_MAX_NOTES * MIDI_BUFFER_NOTE_EVENT_BYTES);
+        juce::Random random(BENCHMARK_RANDOM_SEED);
+        
+        const juce::int64 iNumBlocks = GetNumBlocks(iMinEventsPerCase, iEventsPerBlock);
+        BlockTimer timer(iNumBlocks);
+        juce::int64 iChecksum = 0;
+        
+        for(juce::int64 iBlock = 0; iBlock < iNumBlocks; iBlock++)
+        {
+            processedMidi.clear();
+            keyboardStateFifo.Drain(keyboardState);
+            
+            timer.Start();
+            {
+                RealtimeAllocations::ScopedNoAllocationRegion noAllocationRegion;
+                RealtimeAllocations::ScopedStorageCheck<juce::Array<juce::uint8>> processedStorageCheck(processedMidi.data);
+                
+                const juce::int64 iBlockStart = iBlock * iEventsPerBlock;
+                
+                for(int i=0; i<iEventsPerBlock; i++)
+                {
+                    // Alternate chord starts and ends, as the processor does
+                    if((i & 1) == 0)
+                        chord.Setup(36 + random.nextInt(48), 1, Chords::Type::MajorSeventh, 100, 0.0);
+                    
+                    chord.GenerateMidi((i & 1) == 0, iBlockStart + i, noteScheduler, &keyboardStateFifo);
+                }
+                
+                noteScheduler.RenderBlock(iBlockStart, iEventsPerBlock, processedMidi);
+            }
+            timer.Stop();
+            
+            iChecksum += processedMidi.getNumEvents();
+        }
+        
+        return timer.GetResult("PressedChord::GenerateMidi", 0, iEventsPerBlock, iChecksum);
+    }
+    
+    // Decodes every event of a block the way the processor's event loop reads it: from a MidiMessage
+    // copied by the deprecated MidiBuffer::Iterator (bMessageCopy), or from the buffer's bytes
+    static Result RunBufferWalk(int iEventsPerBlock, bool bMessageCopy, juce::int64 iMinEventsPerCase)
+    {
+        juce::MidiBuffer midiBuffer;
+        juce::Random random(BENCHMARK_RANDOM_SEED);
+        int iHeldNote = -1;
+        FillSyntheticBlock(midiBuffer, random, iEventsPerBlock, iEventsPerBlock, iHeldNote);
+        
+        const juce::int64 iNumBlocks = GetNumBlocks(iMinEventsPerCase, iEventsPerBlock);
+        BlockTimer timer(iNumBlocks);
+        juce::int64 iChecksum = 0;
+        
+        for(juce::int64 iBlock = 0; iBlock < iNumBlocks; iBlock++)
+        {
+            timer.Start();
+            {
+                RealtimeAllocations::ScopedNoAllocationRegion noAllocationRegion;
+                
+                if(bMessageCopy)
+                {
+                    JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
+                    JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
+                    
+                    int iSamplePosition;
+                    juce::MidiMessage m;
+                    
+                    for (juce::MidiBuffer::Iterator i (midiBuffer); i.getNextEvent (m, iSamplePosition);)
+                    {
+                        if(m.isNoteOn())
+                            iChecksum += m.getNoteNumber() + m.getVelocity() + m.getChannel() + iSamplePosition;
+                        else if(m.isNoteOff())
+                            iChecksum -= m.getNoteNumber() + m.getChannel() + iSamplePosition;
+                    }
+                    
+                    JUCE_END_IGNORE_WARNINGS_MSVC
+                    JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+                }
+                else
+                {
+                    for(const auto metadata : midiBuffer)
+                    {
+                        const int iStatus = metadata.data[0] & 0xf0;
+                        const int iChannel = (metadata.data[0] & 0x0f) + 1;
+                        
+                        if(iStatus == 0x90 && metadata.data[2] != 0)
+                            iChecksum += metadata.data[1] + metadata.data[2] + iChannel + metadata.samplePosition;
+                        else if(iStatus == 0x80 || iStatus == 0x90)
+                            iChecksum -= metadata.data[1] + iChannel + metadata.samplePosition;
+                    }
+                }
+            }
+            timer.Stop();
+        }
+        
+        return timer.GetResult(bMessageCopy ? "MidiBuffer walk (MidiMessage)" : "MidiBuffer walk (metadata)", 0, iEventsPerBlock, iChecksum);
+    }
+    
+    static Result RunIsNoteInScale(juce::int64 iMinEventsPerCase)
+    {
+        MidiScalesPluginAudioProcessor processor;
+        processor.SetScaleSafe(2, Scales::Type::HarmonicMinor);
+        
+        juce::uint8 notes[BENCHMARK_CALLS_PER_BATCH];
+        juce::Random random(BENCHMARK_RANDOM_SEED);
+        for(auto& note : notes)
+            note = (juce::uint8) random.nextInt(SCALES_TOTAL_STEPS);
+        
+        const juce::int64 iNumBlocks = GetNumBlocks(iMinEventsPerCase, BENCHMARK_CALLS_PER_BATCH);
+        BlockTimer timer(iNumBlocks);
+        juce::int64 iNumInScale = 0;
+        
+        for(juce::int64 iBlock = 0; iBlock < iNumBlocks; iBlock++)
+        {
+            timer.Start();
+            {
+                RealtimeAllocations::ScopedNoAllocationRegion noAllocationRegion;
+                for(auto note : notes)
+                    iNumInScale += processor.IsNoteInScaleSafe(note) ? 1 : 0;
+            }
+            timer.Stop();
+        }
+        
+        return timer.GetResult("IsNoteInScaleSafe", 0, BENCHMARK_CALLS_PER_BATCH, iNumInScale);
+    }
+    
+    static Result RunGetChordSequence(juce::int64 iMinEventsPerCase)
+    {
+        const juce::int64 iNumBlocks = GetNumBlocks(iMinEventsPerCase, BENCHMARK_CALLS_PER_BATCH);
+        BlockTimer timer(iNumBlocks);
+        juce::int64 iTotalNotes = 0;
+        const int iNumChordIds = juce::jmax(1, ScaleLibrary::GetInstance().GetNumChords() - 1);
+        
+        for(juce::int64 iBlock = 0; iBlock < iNumBlocks; iBlock++)
+        {
+            timer.Start();
+            {
+                RealtimeAllocations::ScopedNoAllocationRegion noAllocationRegion;
+                for(int i=0; i<BENCHMARK_CALLS_PER_BATCH; i++)
+                    iTotalNotes += Helpers::GetChordSequence((Chords::Type::eType) (1 + i % iNumChordIds)).size();
+            }
+            timer.Stop();
+        }
+        
+        return timer.GetResult("Helpers::GetChordSequence", 0, BENCHMARK_CALLS_PER_BATCH, iTotalNotes);
+    }
+    
+    juce::Array<Result> RunAll(juce::int64 iMinEventsPerCase)
+    {
+        // Count allocations in the timed code instead of stopping on the first one
+        RealtimeAllocations::SetAssertOnAllocation(false);
+        
+        juce::Array<Result> results;
+        
+        for(int iEventsPerBlock : s_eventsPerBlock)
+            for(int iBlockSize : s_blockSizes)
+                results.add(RunProcessBlock(iBlockSize, iEventsPerBlock, false, iMinEventsPerCase));
+        
+        // Only the densities the scheduler reserves strum room for, denser input drops strummed notes
+        const int iMaxStrumSamples = ChordStrummer::GetMaxStrumSamples(BENCHMARK_SAMPLE_RATE);
+        for(int iEventsPerBlock : s_eventsPerBlock)
+            for(int iBlockSize : s_blockSizes)
+                if(iEventsPerBlock * (iMaxStrumSamples / iBlockSize + 1) <= STRUM_MAX_WINDOW_INPUT_EVENTS)
+                    results.add(RunProcessBlock(iBlockSize, iEventsPerBlock, true, iMinEventsPerCase));
+        
+        for(int iEventsPerBlock : s_eventsPerBlock)
+            results.add(RunGenerateMidi(iEventsPerBlock, iMinEventsPerCase));
+        
+        // Side by side, the difference is the per-event cost of copying into a MidiMessage
+        for(int iEventsPerBlock : s_eventsPerBlock)
+        {
+            results.add(RunBufferWalk(iEventsPerBlock, true, iMinEventsPerCase));
+            results.add(RunBufferWalk(iEventsPerBlock, false, iMinEventsPerCase));
+        }
+        
+        results.add(RunIsNoteInScale(iMinEventsPerCase));
+        results.add(RunGetChordSequence(iMinEventsPerCase));
+        
+        RealtimeAllocations::SetAssertOnAllocation(true);
+        
+        return results;
+    }
+    
+    void PrintTable(const juce::Array<Result>& results, std::ostream& stream)
+    {
+        stream << std::left << std::setw(30) << "case"
+               << std::right << std::setw(8) << "block" << std::setw(8) << "events"
+               << std::setw(12) << "ns/event" << std::setw(12) << "mean us"
+               << std::setw(12) << "p99.9 us" << std::setw(12) << "max us"
+               << std::setw(8) << "allocs" << std::setw(16) << "checksum" << std::endl;
+        
+        stream << std::fixed << std::setprecision(2);
+        
+        for(const auto& result : results)
+        {
+            stream << std::left << std::setw(30) << result.name
+                   << std::right << std::setw(8) << result.iBlockSize << std::setw(8) << result.iEventsPerBlock
+                   << std::setw(12) << result.dNanosPerEvent << std::setw(12) << result.dMeanBlockMicros
+                   << std::setw(12) << result.dP999BlockMicros << std::setw(12) << result.dMaxBlockMicros
+                   << std::setw(8) << result.iAllocations << std::setw(16) << result.iChecksum << std::endl;
+        }
+    }
+    
+    void WriteCsv(const juce::Array<Result>& results, std::ostream& stream)
+    {
+        stream << "case,block_size,events_per_block,blocks,ns_per_event,mean_block_us,p999_block_us,max_block_us,allocations,checksum" << std::endl;
+        
+        for(const auto& result : results)
+        {
+            stream << result.name << ',' << result.iBlockSize << ',' << result.iEventsPerBlock << ',' << result.iNumBlocks << ','
+                   << result.dNanosPerEvent << ',' << result.dMeanBlockMicros << ',' << result.dP999BlockMicros << ','
+                   << result.dMaxBlockMicros << ',' << result.iAllocations << ',' << result.iChecksum << std::endl;
+        }
+    }
+}
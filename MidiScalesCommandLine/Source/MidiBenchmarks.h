@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    MidiBenchmarks.h
+    Created: 17 Oct 2026 3:05:48pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Microbenchmarks for the MIDI hot path: processBlock, PressedChord::GenerateMidi, walking a
+// MidiBuffer, IsNoteInScaleSafe and Helpers::GetChordSequence over synthetic event streams.
+namespace MidiBenchmarks
+{
+    struct Result
+    {
+        juce::String name;
+        int iBlockSize = 0;             // Samples per block, 0 for cases that have no block
+        int iEventsPerBlock = 0;        // Events (or calls) timed together as one block
+        juce::int64 iNumBlocks = 0;
+        double dNanosPerEvent = 0.0;
+        double dMeanBlockMicros = 0.0;
+        double dP999BlockMicros = 0.0;  // 99.9th percentile block time
+        double dMaxBlockMicros = 0.0;
+        juce::int64 iAllocations = 0;   // Heap allocations inside the timed code, see RealtimeAllocations
+        juce::int64 iChecksum = 0;      // Folded from the timed code's results and printed, so none of it can be optimised away
+    };
+    
+    // Event densities and block sizes every processBlock case is run with
+    const int s_eventsPerBlock[] = { 1, 64, 1024 };
+    const int s_blockSizes[] = { 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    
+    // iMinEventsPerCase sets how long each case runs, fewer is quicker but noisier
+    juce::Array<Result> RunAll(juce::int64 iMinEventsPerCase);
+    
+    void PrintTable(const juce::Array<Result>& results, std::ostream& stream);
+    // One row per result, stable column order so runs can be diffed between releases
+    void WriteCsv(const juce::Array<Result>& results, std::ostream& stream);
+}
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    OfflineMidiRenderer.cpp
+    Created: 17 Oct 2026 1:24:32pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "OfflineMidiRenderer.h"
+
+#define OFFLINE_OUTPUT_TICKS_PER_QUARTER 960
+
+double OfflineMidiRenderer::Result::GetInputEventsPerSecond() const
+{
+    return dProcessingSeconds > 0.0 ? (double) iNumInputEvents / dProcessingSeconds : 0.0;
+}
+
+double OfflineMidiRenderer::Result::GetOutputEventsPerSecond() const
+{
+    return dProcessingSeconds > 0.0 ? (double) iNumOutputEvents / dProcessingSeconds : 0.0;
+}
+
+OfflineMidiRenderer::OfflineMidiRenderer(const Settings& settings)
+: m_settings(settings)
+{
+    m_iBlockStartSample = 0;
+    m_processor.setPlayHead(this);
+    
+    m_processor.SetScaleSafe(m_settings.iScaleNote, m_settings.scaleType);
+    m_processor.m_ChordType.set(m_settings.chordType);
+    m_processor.m_QuantizeMode.set(m_settings.quantizeMode);
+    m_processor.m_bDiatonicChords.set(m_settings.bDiatonicChords);
+    m_processor.m_VoicingMode.set(m_settings.voicingMode);
+    m_processor.m_iVoicingLowNote.set(m_settings.iVoicingLowNote);
+    m_processor.m_iVoicingHighNote.set(m_settings.iVoicingHighNote);
+    m_processor.m_iStrumMs.set(m_settings.iStrumMs);
+    m_processor.m_StrumDirection.set(m_settings.strumDirection);
+    m_processor.m_iStrumVelocityCurve.set(m_settings.iStrumVelocityCurve);
+    m_processor.m_iHumanize.set(m_settings.iHumanize);
+    m_processor.m_bArpeggiator.set(m_settings.bArpeggiator);
+    m_processor.m_ArpPattern.set(m_settings.arpPattern);
+    m_processor.m_ArpRate.set(m_settings.arpRate);
+    m_processor.m_iArpGate.set(m_settings.iArpGate);
+    m_processor.m_bMpe.set(m_settings.bMpe);
+}
+
+OfflineMidiRenderer::~OfflineMidiRenderer()
+{
+    m_processor.setPlayHead(nullptr);
+}
+
+void OfflineMidiRenderer::MergeTracks(const juce::MidiFile& midiFile, juce::MidiMessageSequence& mergedSequence)
+{
+    for(int i=0; i<midiFile.getNumTracks(); i++)
+        mergedSequence.addSequence(*midiFile.getTrack(i), 0.0);
+    
+    mergedSequence.sort();
+}
+
+OfflineMidiRenderer::Result OfflineMidiRenderer::Render(const juce::MidiFile& inputFile, juce::MidiFile& outputFile)
+{
+    Result result;
+    
+    // Work in seconds so the input tempo map is honoured
+    juce::MidiFile inputInSeconds(inputFile);
+    inputInSeconds.convertTimestampTicksToSeconds();
+    
+    juce::MidiMessageSequence inputSequence;
+    MergeTracks(inputInSeconds, inputSequence);
+    
+    const double dSampleRate = m_settings.dSampleRate;
+    const int iBlockSize = m_settings.iBlockSize;
+    const juce::int64 iTotalSamples = (juce::int64) ((inputSequence.getEndTime() + m_settings.dTailSeconds) * dSampleRate);
+    
+    const double dTicksPerSecond = OFFLINE_OUTPUT_TICKS_PER_QUARTER * m_settings.dTempoBpm / 60.0;
+    juce::MidiMessageSequence outputSequence;
+    outputSequence.addEvent(juce::MidiMessage::tempoMetaEvent((int) (60000000.0 / m_settings.dTempoBpm)));
+    
+    juce::AudioBuffer<float> audioBuffer(juce::jmax(m_processor.getTotalNumInputChannels(), m_processor.getTotalNumOutputChannels()), iBlockSize);
+    juce::MidiBuffer midiBuffer;
+    
+    m_processor.setRateAndBufferSizeDetails(dSampleRate, iBlockSize);
+    m_processor.prepareToPlay(dSampleRate, iBlockSize);
+    // Reserved up front like a host's buffer, processBlock reports it growing as an allocation
+    midiBuffer.ensureSize(m_processor.GetMidiBufferBytes());
+    m_processor.m_processingStats.Attach();
+    
+    int iNextInputEvent = 0;
+    const int iNumInputEvents = inputSequence.getNumEvents();
+    
+    for(juce::int64 iBlockStart = 0; iBlockStart < iTotalSamples; iBlockStart += iBlockSize)
+    {
+        const juce::int64 iBlockEnd = iBlockStart + iBlockSize;
+        midiBuffer.clear();
+        
+        for(; iNextInputEvent < iNumInputEvents; iNextInputEvent++)
+        {
+            const juce::MidiMessage& message = inputSequence.getEventPointer(iNextInputEvent)->message;
+            const juce::int64 iEventSample = (juce::int64) (message.getTimeStamp() * dSampleRate + 0.5);
+            
+            if(iEventSample >= iBlockEnd)
+                break;
+            
+            // Meta events only mean something inside a file, never send them to the processor
+            if(message.isMetaEvent())
+                continue;
+            
+            midiBuffer.addEvent(message, (int) (iEventSample - iBlockStart));
+            result.iNumInputEvents++;
+        }
+        
+        m_iBlockStartSample = iBlockStart;
+        
+        const juce::int64 iStartTicks = juce::Time::getHighResolutionTicks();
+        m_processor.processBlock(audioBuffer, midiBuffer);
+        result.dProcessingSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - iStartTicks);
+        result.iNumBlocks++;
+        
+        // Collect every block, the processor's stats FIFO only holds PROCESSING_STATS_FIFO_SIZE of them
+        result.blockStats = m_processor.m_processingStats.Update();
+        
+        for(const auto metadata : midiBuffer)
+        {
+            const double dSeconds = (double) (iBlockStart + metadata.samplePosition) / dSampleRate;
+            outputSequence.addEvent(juce::MidiMessage(metadata.data, metadata.numBytes, dSeconds * dTicksPerSecond));
+            result.iNumOutputEvents++;
+        }
+    }
+    
+    m_processor.m_processingStats.Detach();
+    m_processor.releaseResources();
+    
+    outputSequence.updateMatchedPairs();
+    outputFile.clear();
+    outputFile.setTicksPerQuarterNote(OFFLINE_OUTPUT_TICKS_PER_QUARTER);
+    outputFile.addTrack(outputSequence);
+    
+    return result;
+}
+
+bool OfflineMidiRenderer::getCurrentPosition(CurrentPositionInfo& result)
+{
+    result.resetToDefault();
+    
+    result.bpm = m_settings.dTempoBpm;
+    result.timeInSamples = m_iBlockStartSample;
+    result.timeInSeconds = (double) m_iBlockStartSample / m_settings.dSampleRate;
+    result.ppqPosition = result.timeInSeconds * m_settings.dTempoBpm / 60.0;
+    result.ppqPositionOfLastBarStart = std::floor(result.ppqPosition / 4.0) * 4.0;
+    result.isPlaying = true;
+    
+    return true;
+}
+
+bool OfflineMidiRenderer::RenderFile(const juce::File& inputFile, const juce::File& outputFile, Result& result, juce::String& errorMessage)
+{
+    juce::MidiFile inputMidi;
+    
+    {
+        juce::FileInputStream inputStream(inputFile);
+        if(!inputStream.openedOk() || !inputMidi.readFrom(inputStream))
+        {
+            errorMessage = "Couldn't read MIDI file: " + inputFile.getFullPathName();
+            return false;
+        }
+    }
+    
+    juce::MidiFile outputMidi;
+    result = Render(inputMidi, outputMidi);
+    
+    // FileOutputStream appends to existing files
+    outputFile.deleteFile();
+    juce::FileOutputStream outputStream(outputFile);
+    if(!outputStream.openedOk() || !outputMidi.writeTo(outputStream))
+    {
+        errorMessage = "Couldn't write MIDI file: " + outputFile.getFullPathName();
+        return false;
+    }
+    
+    return true;
+}
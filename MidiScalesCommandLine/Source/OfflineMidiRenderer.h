@@ -0,0 +1,84 @@
+/*
+  ==============================================================================
+
+    OfflineMidiRenderer.h
+    Created: 17 Oct 2026 1:24:10pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../MidiScalesPlugin/Source/PluginProcessor.h"
+
+// Streams a MIDI file through MidiScalesPluginAudioProcessor::processBlock in
+// fixed size blocks, without an audio device, and collects the processed MIDI.
+// Acts as the processor's playhead, a transport playing from the start of the file.
+class OfflineMidiRenderer  : private juce::AudioPlayHead
+{
+public:
+    struct Settings
+    {
+        double dSampleRate = 44100.0;
+        int iBlockSize = 512;
+        int iScaleNote = 0;
+        Scales::Type::eType scaleType = Scales::Type::Major;
+        Chords::Type::eType chordType = Chords::Type::MajorTriad;
+        Quantize::Mode::eMode quantizeMode = Quantize::Mode::Off;
+        bool bDiatonicChords = false;
+        Voicing::Mode::eMode voicingMode = Voicing::Mode::RootPosition;
+        int iVoicingLowNote = VOICING_DEFAULT_LOW_NOTE;
+        int iVoicingHighNote = VOICING_DEFAULT_HIGH_NOTE;
+        int iStrumMs = 0;
+        Strum::Direction::eDirection strumDirection = Strum::Direction::Up;
+        int iStrumVelocityCurve = 0;
+        int iHumanize = 0;
+        bool bArpeggiator = false;
+        Arpeggio::Pattern::ePattern arpPattern = Arpeggio::Pattern::Up;
+        Arpeggio::Rate::eRate arpRate = Arpeggio::Rate::Sixteenth;
+        int iArpGate = ARPEGGIATOR_DEFAULT_GATE;
+        bool bMpe = false;
+        // Tempo the playhead reports, also the output file's tempo
+        double dTempoBpm = 120.0;
+        // Extra time rendered after the last input event so pending note-offs come out
+        double dTailSeconds = 1.0;
+    };
+    
+    struct Result
+    {
+        juce::int64 iNumInputEvents = 0;
+        juce::int64 iNumOutputEvents = 0;
+        juce::int64 iNumBlocks = 0;
+        // Time spent inside processBlock only, file IO is not included
+        double dProcessingSeconds = 0.0;
+        // The processor's own per-block stats over the most recent blocks
+        ProcessingStats::Summary blockStats;
+        
+        double GetInputEventsPerSecond() const;
+        double GetOutputEventsPerSecond() const;
+    };
+    
+    OfflineMidiRenderer(const Settings& settings);
+    ~OfflineMidiRenderer();
+    
+    // Processes every track of the input merged into one stream. The output is a single
+    // track at a fixed tempo (Settings::dTempoBpm) with the same timing in seconds.
+    Result Render(const juce::MidiFile& inputFile, juce::MidiFile& outputFile);
+    
+    // Returns false and fills errorMessage if either file can't be read/written
+    bool RenderFile(const juce::File& inputFile, const juce::File& outputFile, Result& result, juce::String& errorMessage);
+    
+private:
+    static void MergeTracks(const juce::MidiFile& midiFile, juce::MidiMessageSequence& mergedSequence);
+    
+    // The start of the block being processed
+    bool getCurrentPosition(CurrentPositionInfo& result) override;
+    
+    Settings m_settings;
+    MidiScalesPluginAudioProcessor m_processor;
+    juce::int64 m_iBlockStartSample;
+    
+    JUCE_DECLARE_NON_COPYABLE (OfflineMidiRenderer)
+};
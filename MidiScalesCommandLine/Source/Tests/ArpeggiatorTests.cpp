@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+    ArpeggiatorTests.cpp
+    Created: 17 Oct 2026 11:59:22pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../../MidiScalesPlugin/Source/Arpeggiator.h"
+
+using namespace TestHelpers;
+
+// 120 bpm at 48 kHz, a 1/16 step is 6000 samples
+#define ARPEGGIATOR_TEST_SAMPLE_RATE 48000.0
+#define ARPEGGIATOR_TEST_STEP_SAMPLES 6000
+#define ARPEGGIATOR_TEST_BLOCK_SIZE 512
+
+class ArpeggiatorTests  : public juce::UnitTest
+{
+public:
+    ArpeggiatorTests() : juce::UnitTest("Arpeggiator", UNIT_TEST_CATEGORY) {}
+    
+    void runTest() override
+    {
+        beginTest("Steps land on the grid whatever the block boundaries");
+        {
+            Prepare();
+            RenderPlaying(0.0, 0, 13000);
+            
+            expect(m_noteOns == std::vector<MidiEvent> { NoteOn(0, 1, 60, 100), NoteOn(6000, 1, 64, 100), NoteOn(12000, 1, 67, 100) });
+            expect(m_noteOffs == std::vector<MidiEvent> { NoteOff(3000, 1, 60), NoteOff(9000, 1, 64) });
+        }
+        
+        beginTest("Starting between steps waits for the next one");
+        {
+            Prepare();
+            RenderPlaying(0.1, 0, 7000);
+            
+            // Step 1 is at 0.25 quarter notes, 0.15 after the start
+            expect(m_noteOns == std::vector<MidiEvent> { NoteOn(3600, 1, 60, 100) });
+        }
+        
+        beginTest("A transport jump finds the grid again from the new position");
+        {
+            Prepare();
+            RenderPlaying(0.0, 0, 8192);
+            
+            // Looped back to the start, step 0 plays at the top of the block
+            RenderPlaying(0.0, 8192, 1024);
+            // Located to just past a step, the next one plays 0.15 quarter notes in
+            RenderPlaying(10.1, 9216, 4096);
+            
+            expect(m_noteOns == std::vector<MidiEvent> { NoteOn(0, 1, 60, 100), NoteOn(6000, 1, 64, 100),
+                                                         NoteOn(8192, 1, 67, 100), NoteOn(9216 + 3600, 1, 60, 100) });
+        }
+        
+        beginTest("Positions off by less than half a step are not jumps");
+        {
+            Prepare();
+            
+            // The host's position lags a little behind, no step is played twice or skipped
+            juce::int64 iBlockStart = 0;
+            for(int iBlock = 0; iBlock < 50; iBlock++)
+            {
+                const double dQuarterNotes = iBlockStart / (4.0 * ARPEGGIATOR_TEST_STEP_SAMPLES) - (iBlock % 2) * 0.01;
+                RenderPlaying(dQuarterNotes, iBlockStart, ARPEGGIATOR_TEST_BLOCK_SIZE);
+                iBlockStart += ARPEGGIATOR_TEST_BLOCK_SIZE;
+            }
+            
+            expectEquals((int) m_noteOns.size(), (int) (iBlockStart / ARPEGGIATOR_TEST_STEP_SAMPLES) + 1);
+        }
+        
+        beginTest("A stopped transport runs on at the last tempo");
+        {
+            Prepare();
+            RenderPlaying(0.0, 0, 4096);
+            
+            juce::AudioPlayHead::CurrentPositionInfo position;
+            position.resetToDefault();
+            position.bpm = 120.0;
+            position.isPlaying = false;
+            Render(&position, 4096, 9000);
+            
+            expect(m_noteOns == std::vector<MidiEvent> { NoteOn(0, 1, 60, 100), NoteOn(6000, 1, 64, 100), NoteOn(12000, 1, 67, 100) });
+        }
+    }
+    
+private:
+    // An up arpeggio of C major on channel 1, at the default rate and gate
+    void Prepare()
+    {
+        m_arpeggiator.Prepare(ARPEGGIATOR_TEST_SAMPLE_RATE);
+        m_arpeggiator.SetArpeggio(Arpeggio::Pattern::Up, Arpeggio::Rate::Sixteenth, ARPEGGIATOR_DEFAULT_GATE * 0.01f);
+        m_noteScheduler.Prepare(256);
+        
+        m_chord.Reset();
+        m_chord.Setup(60, 1, Chords::Type::MajorTriad, 100, 0.0);
+        m_arpeggiator.AddChord(m_chord);
+        
+        m_noteOns.clear();
+        m_noteOffs.clear();
+    }
+    
+    // A playing transport at 120 bpm, dQuarterNotes at iStartSample
+    void RenderPlaying(double dQuarterNotes, juce::int64 iStartSample, int iNumSamples)
+    {
+        juce::AudioPlayHead::CurrentPositionInfo position;
+        position.resetToDefault();
+        position.bpm = 120.0;
+        position.isPlaying = true;
+        position.ppqPosition = dQuarterNotes;
+        
+        Render(&position, iStartSample, iNumSamples);
+    }
+    
+    // Renders in blocks, the position is only reported to the first one like a host that
+    // plays on, and collects the notes at absolute sample times
+    void Render(const juce::AudioPlayHead::CurrentPositionInfo* pPosition, juce::int64 iStartSample, int iNumSamples)
+    {
+        juce::AudioPlayHead::CurrentPositionInfo position = *pPosition;
+        juce::MidiBuffer outputMidi;
+        
+        for(int iOffset = 0; iOffset < iNumSamples; iOffset += ARPEGGIATOR_TEST_BLOCK_SIZE)
+        {
+            const juce::int64 iBlockStart = iStartSample + iOffset;
+            const int iBlockSize = juce::jmin(ARPEGGIATOR_TEST_BLOCK_SIZE, iNumSamples - iOffset);
+            
+            m_arpeggiator.BeginBlock(&position, iBlockStart, iBlockSize);
+            m_arpeggiator.RenderSteps(iBlockStart + iBlockSize, m_noteScheduler);
+            
+            outputMidi.clear();
+            m_noteScheduler.RenderBlock(iBlockStart, iBlockSize, outputMidi);
+            
+            for(MidiEvent event : GetEvents(outputMidi))
+            {
+                event.iSamplePosition += (int) iBlockStart;
+                ((event.iStatus & 0xf0) == 0x90 ? m_noteOns : m_noteOffs).push_back(event);
+            }
+            
+            position.ppqPosition += iBlockSize * position.bpm / (60.0 * ARPEGGIATOR_TEST_SAMPLE_RATE);
+        }
+    }
+    
+    Arpeggiator m_arpeggiator;
+    MidiNoteScheduler m_noteScheduler;
+    PressedChord m_chord;
+    
+    std::vector<MidiEvent> m_noteOns;
+    std::vector<MidiEvent> m_noteOffs;
+};
+
+static ArpeggiatorTests s_arpeggiatorTests;
@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    ChordVoicerTests.cpp
+    Created: 17 Oct 2026 11:59:05pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../../MidiScalesPlugin/Source/ChordVoicer.h"
+
+class ChordVoicerTests  : public juce::UnitTest
+{
+public:
+    ChordVoicerTests() : juce::UnitTest("ChordVoicer", UNIT_TEST_CATEGORY) {}
+    
+    void runTest() override
+    {
+        beginTest("Inversions raise the lowest notes an octave, in ascending order");
+        {
+            ChordInversions inversions;
+            ChordVoicer::BuildInversions(MakeIntervalSet<CHORD_MAX_NOTES>({0, 4, 7, 14}), inversions);
+            
+            expectEquals(inversions.numNotes, 4);
+            expect(GetOffsets(inversions, 0) == std::vector<int> { 0, 4, 7, 14 });
+            expect(GetOffsets(inversions, 1) == std::vector<int> { 4, 7, 12, 14 });
+            expect(GetOffsets(inversions, 2) == std::vector<int> { 7, 12, 14, 16 });
+            expect(GetOffsets(inversions, 3) == std::vector<int> { 12, 14, 16, 19 });
+        }
+        
+        beginTest("Root position plays the chord as written, leaving out notes past the MIDI range");
+        {
+            ChordVoicer chordVoicer;
+            const ChordInversions& majorTriad = chordVoicer.GetInversions(Chords::Type::MajorTriad);
+            VoicedChord voicedChord;
+            
+            chordVoicer.Voice(majorTriad, 60, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 60, 64, 67 });
+            
+            chordVoicer.Voice(majorTriad, 122, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 122, 126 });
+        }
+        
+        beginTest("Voice leading moves to the closest inversion");
+        {
+            ChordVoicer chordVoicer;
+            chordVoicer.SetVoicing(Voicing::Mode::VoiceLeading, VOICING_DEFAULT_LOW_NOTE, VOICING_DEFAULT_HIGH_NOTE);
+            const ChordInversions& majorTriad = chordVoicer.GetInversions(Chords::Type::MajorTriad);
+            VoicedChord voicedChord;
+            
+            // The first chord has nothing to lead from, it stays in root position
+            chordVoicer.Voice(majorTriad, 60, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 60, 64, 67 });
+            
+            // F major keeps the C and moves the others by a step, second inversion
+            chordVoicer.Voice(majorTriad, 65, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 60, 65, 69 });
+            
+            // G major an octave up still leads from the F major
+            chordVoicer.Voice(majorTriad, 79, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 59, 62, 67 });
+            
+            // After a reset the next chord starts again from root position
+            chordVoicer.Reset();
+            chordVoicer.Voice(majorTriad, 65, voicedChord);
+            expect(GetNotes(voicedChord) == std::vector<int> { 65, 69, 72 });
+        }
+        
+        beginTest("Voice leading keeps every note inside the register");
+        {
+            ChordVoicer chordVoicer;
+            chordVoicer.SetVoicing(Voicing::Mode::VoiceLeading, 60, 72);
+            const ChordInversions& majorTriad = chordVoicer.GetInversions(Chords::Type::MajorTriad);
+            VoicedChord voicedChord;
+            
+            for(int iRootNote : { 79, 36, 100, 61, 0, 127 })
+            {
+                chordVoicer.Voice(majorTriad, iRootNote, voicedChord);
+                expectEquals(voicedChord.size(), 3);
+                
+                // Still a major triad on the root, whatever inversion and octave
+                for(int iNote : voicedChord)
+                {
+                    expect(iNote >= 60 && iNote <= 72);
+                    
+                    const int iPitchClass = (iNote - iRootNote + SCALES_TOTAL_STEPS * SCALES_OCTAVE_STEPS) % SCALES_OCTAVE_STEPS;
+                    expect(iPitchClass == 0 || iPitchClass == 4 || iPitchClass == 7);
+                }
+            }
+        }
+        
+        beginTest("Every voicer shares one inversion table");
+        {
+            ChordVoicer firstVoicer;
+            ChordVoicer secondVoicer;
+            expect(&firstVoicer.GetInversions(Chords::Type::MinorSeventh) == &secondVoicer.GetInversions(Chords::Type::MinorSeventh));
+        }
+    }
+    
+private:
+    static std::vector<int> GetOffsets(const ChordInversions& inversions, int iInversion)
+    {
+        return std::vector<int>(inversions.offsets[iInversion], inversions.offsets[iInversion] + inversions.numNotes);
+    }
+    
+    static std::vector<int> GetNotes(const VoicedChord& voicedChord)
+    {
+        return std::vector<int>(voicedChord.begin(), voicedChord.end());
+    }
+};
+
+static ChordVoicerTests s_chordVoicerTests;
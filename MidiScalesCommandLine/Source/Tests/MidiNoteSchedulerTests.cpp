@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    MidiNoteSchedulerTests.cpp
+    Created: 17 Oct 2026 11:58:40pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../../MidiScalesPlugin/Source/MidiNoteScheduler.h"
+
+using namespace TestHelpers;
+
+class MidiNoteSchedulerTests  : public juce::UnitTest
+{
+public:
+    MidiNoteSchedulerTests() : juce::UnitTest("MidiNoteScheduler", UNIT_TEST_CATEGORY) {}
+    
+    void runTest() override
+    {
+        MidiNoteScheduler scheduler;
+        juce::MidiBuffer outputMidi;
+        
+        beginTest("Events come out in their own block, at block relative positions");
+        {
+            scheduler.Prepare(256);
+            scheduler.ScheduleNoteOn(10, 1, 60, 100, 1);
+            scheduler.ScheduleNoteOff(600, 1, 60, 1);
+            
+            RenderBlock(scheduler, 0, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(10, 1, 60, 100) });
+            expectEquals(scheduler.GetNumPending(), 1);
+            expect(scheduler.IsNoteSounding(1, 60));
+            
+            RenderBlock(scheduler, 512, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOff(88, 1, 60) });
+            expectEquals(scheduler.GetNumPending(), 0);
+            expect(!scheduler.IsNoteSounding(1, 60));
+        }
+        
+        beginTest("Events scheduled in the past go out at the start of the block");
+        {
+            scheduler.Prepare(256);
+            scheduler.ScheduleNoteOn(100, 2, 64, 90, 1);
+            
+            RenderBlock(scheduler, 512, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(0, 2, 64, 90) });
+        }
+        
+        beginTest("A note-off and note-on of different voices at the same sample cancel out");
+        {
+            scheduler.Prepare(256);
+            scheduler.ScheduleNoteOn(0, 1, 60, 100, 1);
+            scheduler.ScheduleNoteOff(100, 1, 60, 1);
+            scheduler.ScheduleNoteOn(100, 1, 60, 80, 2);
+            scheduler.ScheduleNoteOff(300, 1, 60, 2);
+            
+            RenderBlock(scheduler, 0, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(0, 1, 60, 100), NoteOff(300, 1, 60) });
+            
+            // The note-on comes first in the schedule, the note-off still takes it over
+            scheduler.ScheduleNoteOn(600, 1, 62, 100, 3);
+            scheduler.ScheduleNoteOn(700, 1, 62, 100, 4);
+            scheduler.ScheduleNoteOff(700, 1, 62, 3);
+            
+            RenderBlock(scheduler, 512, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(88, 1, 62, 100) });
+            expect(scheduler.IsNoteSounding(1, 62));
+        }
+        
+        beginTest("A note-off and note-on of the same voice re-articulate the note");
+        {
+            scheduler.Prepare(256);
+            scheduler.ScheduleNoteOn(0, 1, 60, 100, 1);
+            scheduler.ScheduleNoteOn(100, 1, 60, 70, 1);
+            scheduler.ScheduleNoteOff(100, 1, 60, 1);
+            
+            RenderBlock(scheduler, 0, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(0, 1, 60, 100), NoteOff(100, 1, 60), NoteOn(100, 1, 60, 70) });
+        }
+        
+        beginTest("A note shared by two voices is started and ended once");
+        {
+            scheduler.Prepare(256);
+            scheduler.ScheduleNoteOn(0, 1, 67, 100, 1);
+            scheduler.ScheduleNoteOn(50, 1, 67, 100, 2);
+            scheduler.ScheduleNoteOff(100, 1, 67, 1);
+            scheduler.ScheduleNoteOff(200, 1, 67, 2);
+            
+            RenderBlock(scheduler, 0, outputMidi);
+            expect(GetEvents(outputMidi) == std::vector<MidiEvent> { NoteOn(0, 1, 67, 100), NoteOff(200, 1, 67) });
+        }
+        
+        beginTest("A channel is active until its last note-off has gone out");
+        {
+            scheduler.Prepare(256);
+            expect(!scheduler.IsChannelActive(2));
+            
+            scheduler.ScheduleNoteOn(100, 2, 60, 100, 1);
+            scheduler.ScheduleNoteOn(100, 2, 64, 100, 1);
+            expect(scheduler.IsChannelActive(2));
+            
+            scheduler.ScheduleNoteOff(200, 2, 60, 1);
+            scheduler.ScheduleNoteOff(700, 2, 64, 1);
+            
+            RenderBlock(scheduler, 0, outputMidi);
+            expect(scheduler.IsChannelActive(2));
+            expectEquals(scheduler.GetChannelReleaseTime(2), (juce::int64) 0);
+            
+            RenderBlock(scheduler, 512, outputMidi);
+            expect(!scheduler.IsChannelActive(2));
+            expectEquals(scheduler.GetChannelReleaseTime(2), (juce::int64) 700);
+            expect(!scheduler.IsChannelActive(1));
+        }
+        
+        beginTest("A full queue refuses note-ons before note-offs");
+        {
+            // Room for two note-ons on top of the reserve for ending every chord
+            const int iReserve = CHORD_MAX_VOICES * CHORD_MAX_NOTES;
+            scheduler.Prepare(iReserve + 2);
+            
+            expect(scheduler.ScheduleNoteOn(0, 1, 60, 100, 1));
+            expect(scheduler.ScheduleNoteOn(0, 1, 64, 100, 1));
+            expect(!scheduler.ScheduleNoteOn(0, 1, 67, 100, 1));
+            
+            for(int i=0; i<iReserve; i++)
+                expect(scheduler.ScheduleNoteOff(1000, 1, i % SCALES_TOTAL_STEPS, 1));
+            
+            expect(!scheduler.ScheduleNoteOff(1000, 1, 60, 1));
+            expectEquals(scheduler.GetNumPending(), iReserve + 2);
+            
+            scheduler.Reset();
+            expectEquals(scheduler.GetNumPending(), 0);
+            expect(scheduler.ScheduleNoteOn(0, 1, 67, 100, 1));
+        }
+    }
+    
+private:
+    static void RenderBlock(MidiNoteScheduler& scheduler, juce::int64 iBlockStart, juce::MidiBuffer& outputMidi)
+    {
+        outputMidi.clear();
+        scheduler.RenderBlock(iBlockStart, 512, outputMidi);
+    }
+};
+
+static MidiNoteSchedulerTests s_midiNoteSchedulerTests;
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    MpeRouterTests.cpp
+    Created: 17 Oct 2026 11:59:37pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../../MidiScalesPlugin/Source/MpeRouter.h"
+
+class MpeRouterTests  : public juce::UnitTest
+{
+public:
+    MpeRouterTests() : juce::UnitTest("MpeRouter", UNIT_TEST_CATEGORY) {}
+    
+    void runTest() override
+    {
+        MpeRouter mpeRouter;
+        MidiNoteScheduler noteScheduler;
+        juce::MidiBuffer outputMidi;
+        
+        beginTest("Released channels stay in use until their note-offs have gone out");
+        {
+            mpeRouter.Reset();
+            noteScheduler.Prepare(256);
+            
+            // Takes every member channel, then releases the first chord with its note-off still queued
+            juce::uint8 firstChannels[1] = {};
+            mpeRouter.AllocateChannels(1, noteScheduler, firstChannels);
+            noteScheduler.ScheduleNoteOn(0, firstChannels[0], 60, 100, 1);
+            noteScheduler.ScheduleNoteOff(1000, firstChannels[0], 60, 1);
+            mpeRouter.ReleaseChannels(firstChannels, 1);
+            
+            const int iNumMemberChannels = MPE_LAST_MEMBER_CHANNEL - MPE_FIRST_MEMBER_CHANNEL + 1;
+            juce::uint8 otherChannels[MIDI_CHANNELS] = {};
+            mpeRouter.AllocateChannels(iNumMemberChannels - 1, noteScheduler, otherChannels);
+            
+            for(int i = 0; i < iNumMemberChannels - 1; i++)
+                expect(otherChannels[i] != firstChannels[0]);
+            
+            // Once its note has ended it is the only channel without tones
+            noteScheduler.RenderBlock(0, 2048, outputMidi);
+            
+            juce::uint8 nextChannel[1] = {};
+            mpeRouter.AllocateChannels(1, noteScheduler, nextChannel);
+            expectEquals((int) nextChannel[0], (int) firstChannels[0]);
+        }
+        
+        beginTest("Free channels released the longest ago go first");
+        {
+            mpeRouter.Reset();
+            noteScheduler.Prepare(256);
+            
+            juce::uint8 toneChannels[2] = {};
+            mpeRouter.AllocateChannels(2, noteScheduler, toneChannels);
+            expect(toneChannels[0] != toneChannels[1]);
+            
+            noteScheduler.ScheduleNoteOn(0, toneChannels[0], 60, 100, 1);
+            noteScheduler.ScheduleNoteOn(0, toneChannels[1], 64, 100, 1);
+            noteScheduler.ScheduleNoteOff(300, toneChannels[1], 64, 1);
+            noteScheduler.ScheduleNoteOff(400, toneChannels[0], 60, 1);
+            mpeRouter.ReleaseChannels(toneChannels, 2);
+            noteScheduler.RenderBlock(0, 512, outputMidi);
+            
+            // Every other channel was never used, so they come before both
+            const int iNumMemberChannels = MPE_LAST_MEMBER_CHANNEL - MPE_FIRST_MEMBER_CHANNEL + 1;
+            juce::uint8 allChannels[MIDI_CHANNELS] = {};
+            mpeRouter.AllocateChannels(iNumMemberChannels, noteScheduler, allChannels);
+            
+            expectEquals((int) allChannels[iNumMemberChannels - 2], (int) toneChannels[1]);
+            expectEquals((int) allChannels[iNumMemberChannels - 1], (int) toneChannels[0]);
+        }
+    }
+};
+
+static MpeRouterTests s_mpeRouterTests;
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    SustainTrackerTests.cpp
+    Created: 17 Oct 2026 11:59:51pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../../MidiScalesPlugin/Source/SustainTracker.h"
+
+class SustainTrackerTests  : public juce::UnitTest
+{
+public:
+    SustainTrackerTests() : juce::UnitTest("SustainTracker", UNIT_TEST_CATEGORY) {}
+    
+    void runTest() override
+    {
+        SustainTracker sustainTracker;
+        juce::uint8 latchedNotes[SCALES_TOTAL_STEPS];
+        
+        beginTest("The pedal is tracked per channel");
+        {
+            sustainTracker.Reset();
+            sustainTracker.SetPedalDown(1, true);
+            sustainTracker.SetPedalDown(16, true);
+            
+            expect(sustainTracker.IsPedalDown(1));
+            expect(!sustainTracker.IsPedalDown(2));
+            expect(sustainTracker.IsPedalDown(16));
+            
+            sustainTracker.SetPedalDown(1, false);
+            expect(!sustainTracker.IsPedalDown(1));
+            expect(sustainTracker.IsPedalDown(16));
+            
+            // Out of range channels are ignored
+            sustainTracker.SetPedalDown(0, true);
+            sustainTracker.SetPedalDown(17, true);
+            expect(!sustainTracker.IsPedalDown(0));
+            expect(!sustainTracker.IsPedalDown(17));
+        }
+        
+        beginTest("Latched keys are taken lowest first, once");
+        {
+            sustainTracker.Reset();
+            for(int iNote : { 127, 64, 3, 63, 0 })
+                sustainTracker.Latch(2, iNote);
+            sustainTracker.Latch(3, 60);
+            
+            const int iNumNotes = sustainTracker.TakeLatched(2, latchedNotes);
+            expect(std::vector<int>(latchedNotes, latchedNotes + iNumNotes) == std::vector<int> { 0, 3, 63, 64, 127 });
+            
+            expectEquals(sustainTracker.TakeLatched(2, latchedNotes), 0);
+            
+            // Other channels keep theirs
+            expectEquals(sustainTracker.TakeLatched(3, latchedNotes), 1);
+            expectEquals((int) latchedNotes[0], 60);
+        }
+        
+        beginTest("A key played again is no longer latched");
+        {
+            sustainTracker.Reset();
+            sustainTracker.Latch(1, 60);
+            sustainTracker.Latch(1, 64);
+            sustainTracker.Latch(1, 60);
+            sustainTracker.Unlatch(1, 60);
+            
+            expectEquals(sustainTracker.TakeLatched(1, latchedNotes), 1);
+            expectEquals((int) latchedNotes[0], 64);
+        }
+        
+        beginTest("Reset lifts the pedals and forgets the latched keys");
+        {
+            sustainTracker.SetPedalDown(5, true);
+            sustainTracker.Latch(5, 72);
+            sustainTracker.Reset();
+            
+            expect(!sustainTracker.IsPedalDown(5));
+            expectEquals(sustainTracker.TakeLatched(5, latchedNotes), 0);
+        }
+    }
+};
+
+static SustainTrackerTests s_sustainTrackerTests;
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    TestHelpers.h
+    Created: 17 Oct 2026 11:58:12pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../MidiScalesPlugin/Source/Utilities.h"
+
+#include <vector>
+
+// Every test registers under this category, --test runs all of them
+#define UNIT_TEST_CATEGORY "MidiScales"
+
+namespace TestHelpers
+{
+    // A short MIDI message at its sample position, as the tests compare output
+    struct MidiEvent
+    {
+        int iSamplePosition;
+        int iStatus;
+        int iData1;
+        int iData2;
+        
+        bool operator== (const MidiEvent& other) const
+        {
+            return iSamplePosition == other.iSamplePosition && iStatus == other.iStatus
+                && iData1 == other.iData1 && iData2 == other.iData2;
+        }
+    };
+    
+    inline MidiEvent NoteOn(int iSamplePosition, int iChannel, int iNote, int iVelocity)
+    {
+        return { iSamplePosition, 0x90 | (iChannel - 1), iNote, iVelocity };
+    }
+    
+    inline MidiEvent NoteOff(int iSamplePosition, int iChannel, int iNote)
+    {
+        return { iSamplePosition, 0x80 | (iChannel - 1), iNote, 0 };
+    }
+    
+    // The buffer's events in order, note-ons with velocity 0 read as note-offs
+    inline std::vector<MidiEvent> GetEvents(const juce::MidiBuffer& midiBuffer)
+    {
+        std::vector<MidiEvent> events;
+        
+        for(const auto metadata : midiBuffer)
+        {
+            const juce::uint8* pData = metadata.data;
+            int iStatus = pData[0];
+            const int iData1 = metadata.numBytes > 1 ? pData[1] : 0;
+            const int iData2 = metadata.numBytes > 2 ? pData[2] : 0;
+            
+            if((iStatus & 0xf0) == 0x90 && iData2 == 0)
+                iStatus = 0x80 | (iStatus & 0x0f);
+            
+            events.push_back({ metadata.samplePosition, iStatus, iData1, iData2 });
+        }
+        
+        return events;
+    }
+}
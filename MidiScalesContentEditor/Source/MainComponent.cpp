@@ -3,6 +3,25 @@
 //==============================================================================
 MainComponent::MainComponent()
 {
+    addAndMakeVisible (m_OpenSourceButton);
+    m_OpenSourceButton.onClick = [this] { OpenSourceClicked(); };
+    
+    addAndMakeVisible (m_InstallButton);
+    m_InstallButton.onClick = [this] { InstallClicked(); };
+    m_InstallButton.setEnabled (false);
+    
+    addAndMakeVisible (m_ExportButton);
+    m_ExportButton.onClick = [this] { ExportClicked(); };
+    m_ExportButton.setEnabled (false);
+    
+    addAndMakeVisible (m_SourceLabel);
+    m_SourceLabel.setText ("Open a scale library source (Content/ScaleLibrary.txt) to compile it for the scales plugin", juce::dontSendNotification);
+    
+    addAndMakeVisible (m_LogEditor);
+    m_LogEditor.setMultiLine (true);
+    m_LogEditor.setReadOnly (true);
+    m_LogEditor.setFont (juce::Font (juce::Font::getDefaultMonospacedFontName(), 14.0f, juce::Font::plain));
+    
     setSize (800, 800);
 }
 
@@ -15,15 +34,117 @@ void MainComponent::paint (juce::Graphics& g)
 {
     // (Our component is opaque, so we must completely fill the background with a solid colour)
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setFont (juce::Font (16.0f));
-    g.setColour (juce::Colours::white);
-    g.drawText ("The tool that will be used as the content editor for the resources that will get packed into the scales plugin", getLocalBounds(), juce::Justification::centred, true);
 }
 
 void MainComponent::resized()
 {
-    // This is called when the MainComponent is resized.
-    // If you add any child components, this is where you should
-    // update their positions.
+    const int iSpacing = 10;
+    const int iButtonWidth = 180;
+    const int iButtonHeight = 30;
+    
+    auto area = getLocalBounds().reduced (iSpacing);
+    
+    auto buttonRow = area.removeFromTop (iButtonHeight);
+    m_OpenSourceButton.setBounds (buttonRow.removeFromLeft (iButtonWidth));
+    buttonRow.removeFromLeft (iSpacing);
+    m_InstallButton.setBounds (buttonRow.removeFromLeft (iButtonWidth));
+    buttonRow.removeFromLeft (iSpacing);
+    m_ExportButton.setBounds (buttonRow.removeFromLeft (iButtonWidth));
+    
+    area.removeFromTop (iSpacing);
+    m_SourceLabel.setBounds (area.removeFromTop (iButtonHeight));
+    
+    area.removeFromTop (iSpacing);
+    m_LogEditor.setBounds (area);
+}
+
+void MainComponent::OpenSourceClicked()
+{
+    m_pFileChooser = std::make_unique<juce::FileChooser> ("Open Scale Library Source", m_sourceFile, "*.txt");
+    
+    m_pFileChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                                 [this] (const juce::FileChooser& chooser)
+    {
+        const juce::File sourceFile = chooser.getResult();
+        if(sourceFile == juce::File())
+            return;
+        
+        m_sourceFile = sourceFile;
+        m_SourceLabel.setText (m_sourceFile.getFullPathName(), juce::dontSendNotification);
+        m_InstallButton.setEnabled (true);
+        m_ExportButton.setEnabled (true);
+        
+        // Check it straight away, the library is only written on install/export
+        juce::MemoryBlock libraryData;
+        CompileSource (libraryData);
+    });
+}
+
+void MainComponent::InstallClicked()
+{
+    WriteLibrary (ScaleLibraryFormat::GetUserLibraryFile());
+}
+
+void MainComponent::ExportClicked()
+{
+    m_pFileChooser = std::make_unique<juce::FileChooser> ("Export Scale Library", m_sourceFile.withFileExtension ("mslib"), "*.mslib");
+    
+    m_pFileChooser->launchAsync (juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::warnAboutOverwriting,
+                                 [this] (const juce::FileChooser& chooser)
+    {
+        const juce::File libraryFile = chooser.getResult();
+        if(libraryFile != juce::File())
+            WriteLibrary (libraryFile);
+    });
+}
+
+bool MainComponent::CompileSource (juce::MemoryBlock& destData)
+{
+    // Re-read every time so edits made in a text editor are picked up
+    const juce::String sourceText = m_sourceFile.loadFileAsString();
+    juce::StringArray errors;
+    
+    m_LogEditor.clear();
+    
+    if(!m_compiler.Parse (sourceText, errors))
+    {
+        Log (juce::String (errors.size()) + " error(s) in " + m_sourceFile.getFileName() + ":");
+        for(const juce::String& error : errors)
+            Log ("  " + error);
+        
+        return false;
+    }
+    
+    if(!m_compiler.Write (destData))
+    {
+        Log ("The packed library failed validation");
+        return false;
+    }
+    
+    Log (juce::String (m_compiler.GetNumScales()) + " scales, " + juce::String (m_compiler.GetNumChords()) + " chords, "
+         + juce::String ((juce::int64) destData.getSize()) + " bytes");
+    return true;
+}
+
+void MainComponent::WriteLibrary (const juce::File& libraryFile)
+{
+    juce::MemoryBlock libraryData;
+    if(!CompileSource (libraryData))
+        return;
+    
+    // Plugins that are already running keep the library they mapped, replaceWithData
+    // writes a new file rather than changing the mapped one in place
+    if(!libraryFile.getParentDirectory().createDirectory() || !libraryFile.replaceWithData (libraryData.getData(), libraryData.getSize()))
+    {
+        Log ("Couldn't write " + libraryFile.getFullPathName());
+        return;
+    }
+    
+    Log ("Wrote " + libraryFile.getFullPathName() + ", new plugin instances load it on the next host start");
+}
+
+void MainComponent::Log (const juce::String& text)
+{
+    m_LogEditor.moveCaretToEnd();
+    m_LogEditor.insertTextAtCaret (text + "\n");
 }
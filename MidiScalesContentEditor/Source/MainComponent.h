@@ -1,6 +1,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ScaleLibraryCompiler.h"
 
 //==============================================================================
 /*
@@ -17,11 +18,27 @@ public:
     //==============================================================================
     void paint (juce::Graphics&) override;
     void resized() override;
+    
+    void OpenSourceClicked();
+    void InstallClicked();
+    void ExportClicked();
 
 private:
     //==============================================================================
-    // Your private member variables go here...
-
+    // Compiles the open source file, logs the outcome and returns false on any error
+    bool CompileSource(juce::MemoryBlock& destData);
+    void WriteLibrary(const juce::File& libraryFile);
+    void Log(const juce::String& text);
+    
+    juce::File m_sourceFile;
+    ScaleLibraryCompiler m_compiler;
+    std::unique_ptr<juce::FileChooser> m_pFileChooser;
+    
+    juce::TextButton m_OpenSourceButton {"Open Source..."};
+    juce::TextButton m_InstallButton {"Compile && Install"};
+    juce::TextButton m_ExportButton {"Compile && Export..."};
+    juce::Label m_SourceLabel;
+    juce::TextEditor m_LogEditor;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainComponent)
 };
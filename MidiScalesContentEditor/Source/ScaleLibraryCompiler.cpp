@@ -0,0 +1,294 @@
+/*
+  ==============================================================================
+
+    ScaleLibraryCompiler.cpp
+    Created: 17 Oct 2026 6:48:40pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ScaleLibraryCompiler.h"
+#include "../../MidiScalesPlugin/Source/ScaleLibrary.h"
+
+static juce::uint32 AlignOffset(size_t uOffset)
+{
+    return (juce::uint32) ((uOffset + SCALE_LIBRARY_ALIGNMENT - 1) & ~(size_t) (SCALE_LIBRARY_ALIGNMENT - 1));
+}
+
+static void PadTo(juce::OutputStream& stream, juce::uint32 uOffset)
+{
+    jassert(stream.getPosition() <= uOffset);
+    
+    while(stream.getPosition() < uOffset)
+        stream.writeByte(0);
+}
+
+ScaleLibraryCompiler::ScaleLibraryCompiler()
+{
+}
+
+ScaleLibraryCompiler::~ScaleLibraryCompiler()
+{
+}
+
+bool ScaleLibraryCompiler::Parse(const juce::String& sourceText, juce::StringArray& errors)
+{
+    m_scales.clear();
+    m_chords.clear();
+    errors.clear();
+    
+    juce::StringArray lines;
+    lines.addLines(sourceText);
+    
+    for(int i=0; i<lines.size(); i++)
+    {
+        const juce::String line = lines[i].trim();
+        if(line.isEmpty() || line.startsWithChar('#'))
+            continue;
+        
+        bool bIsScale = false;
+        Entry entry;
+        juce::String error;
+        
+        if(!ParseLine(line, bIsScale, entry, error))
+        {
+            errors.add("Line " + juce::String(i + 1) + ": " + error);
+            continue;
+        }
+        
+        juce::Array<Entry>& entries = bIsScale ? m_scales : m_chords;
+        for(const Entry& existing : entries)
+        {
+            if(existing.iId == entry.iId)
+                error = "ID " + juce::String(entry.iId) + " is already used by " + existing.name;
+        }
+        
+        if(error.isNotEmpty())
+            errors.add("Line " + juce::String(i + 1) + ": " + error);
+        else
+            entries.add(entry);
+    }
+    
+    // Sessions saved without a library refer to the built-in types, they have to mean the same thing
+    const ScaleLibrary builtInLibrary;
+    
+    for(int iId = 1; iId <= Scales::Type::Total; iId++)
+    {
+        bool bFound = false;
+        for(const Entry& entry : m_scales)
+        {
+            if(entry.iId == iId)
+            {
+                bFound = true;
+                if(entry.intervals != juce::Array<int>(builtInLibrary.GetScale(iId).begin(), builtInLibrary.GetScale(iId).size()))
+                    errors.add("Scale " + juce::String(iId) + " must keep the intervals of built-in " + builtInLibrary.GetScaleName(iId));
+            }
+        }
+        
+        if(!bFound)
+            errors.add("Built-in scale " + juce::String(iId) + " (" + builtInLibrary.GetScaleName(iId) + ") is missing");
+    }
+    
+    for(int iId = 1; iId <= Chords::Type::Total; iId++)
+    {
+        bool bFound = false;
+        for(const Entry& entry : m_chords)
+        {
+            if(entry.iId == iId)
+            {
+                bFound = true;
+                if(entry.intervals != juce::Array<int>(builtInLibrary.GetChord(iId).begin(), builtInLibrary.GetChord(iId).size()))
+                    errors.add("Chord " + juce::String(iId) + " must keep the intervals of built-in " + builtInLibrary.GetChordName(iId));
+            }
+        }
+        
+        if(!bFound)
+            errors.add("Built-in chord " + juce::String(iId) + " (" + builtInLibrary.GetChordName(iId) + ") is missing");
+    }
+    
+    return errors.isEmpty();
+}
+
+bool ScaleLibraryCompiler::ParseLine(const juce::String& line, bool& bIsScale, Entry& entry, juce::String& error)
+{
+    juce::StringArray fields;
+    fields.addTokens(line, "|", "");
+    fields.trim();
+    
+    if(fields.size() != 4)
+    {
+        error = "Expected <scale|chord> | <id> | <intervals> | <name>";
+        return false;
+    }
+    
+    if(fields[0] != "scale" && fields[0] != "chord")
+    {
+        error = "Unknown kind \"" + fields[0] + "\"";
+        return false;
+    }
+    bIsScale = fields[0] == "scale";
+    
+    entry.iId = fields[1].getIntValue();
+    if(!fields[1].containsOnly("0123456789") || entry.iId < 1 || entry.iId > 0xffff)
+    {
+        error = "ID must be a number from 1 to 65535";
+        return false;
+    }
+    
+    juce::StringArray intervals;
+    intervals.addTokens(fields[2], " \t", "");
+    intervals.removeEmptyStrings();
+    
+    const int iMaxSteps = bIsScale ? SCALES_OCTAVE_STEPS : CHORD_MAX_NOTES;
+    const int iStepLimit = bIsScale ? SCALES_OCTAVE_STEPS : 32;
+    
+    if(intervals.isEmpty() || intervals.size() > iMaxSteps)
+    {
+        error = "Needs 1 to " + juce::String(iMaxSteps) + " intervals";
+        return false;
+    }
+    
+    entry.intervals.clear();
+    for(const juce::String& interval : intervals)
+    {
+        const int iStep = interval.getIntValue();
+        
+        if(!interval.containsOnly("0123456789") || iStep >= iStepLimit)
+        {
+            error = "Interval \"" + interval + "\" must be a number below " + juce::String(iStepLimit);
+            return false;
+        }
+        
+        if(entry.intervals.isEmpty() ? iStep != 0 : iStep <= entry.intervals.getLast())
+        {
+            error = "Intervals must start at 0 and be ascending";
+            return false;
+        }
+        
+        entry.intervals.add(iStep);
+    }
+    
+    entry.name = fields[3];
+    if(entry.name.isEmpty())
+    {
+        error = "Missing name";
+        return false;
+    }
+    
+    return true;
+}
+
+bool ScaleLibraryCompiler::Write(juce::MemoryBlock& destData) const
+{
+    using namespace ScaleLibraryFormat;
+    
+    const int iNumScaleIds = GetNumIds(m_scales);
+    const int iNumChordIds = GetNumIds(m_chords);
+    
+    // Unused IDs and ID 0 share the name at offset 0
+    juce::MemoryOutputStream strings;
+    strings.writeString("Invalid");
+    
+    juce::Array<juce::uint32> scaleNameOffsets, chordNameOffsets;
+    for(const Entry& entry : m_scales)
+    {
+        scaleNameOffsets.add((juce::uint32) strings.getPosition());
+        strings.writeString(entry.name);
+    }
+    for(const Entry& entry : m_chords)
+    {
+        chordNameOffsets.add((juce::uint32) strings.getPosition());
+        strings.writeString(entry.name);
+    }
+    
+    Header header;
+    juce::zerostruct(header);
+    header.uMagic = SCALE_LIBRARY_MAGIC;
+    header.uVersion = SCALE_LIBRARY_VERSION;
+    header.uScaleRecordBytes = sizeof(ScaleNotes);
+    header.uChordRecordBytes = sizeof(ChordNotes);
+    header.uNumScales = (juce::uint32) iNumScaleIds;
+    header.uNumChords = (juce::uint32) iNumChordIds;
+    header.uScalesOffset = AlignOffset(sizeof(Header));
+    header.uChordsOffset = AlignOffset(header.uScalesOffset + iNumScaleIds * sizeof(ScaleNotes));
+    header.uScaleNamesOffset = AlignOffset(header.uChordsOffset + iNumChordIds * sizeof(ChordNotes));
+    header.uChordNamesOffset = AlignOffset(header.uScaleNamesOffset + iNumScaleIds * sizeof(juce::uint32));
+    header.uStringsOffset = AlignOffset(header.uChordNamesOffset + iNumChordIds * sizeof(juce::uint32));
+    header.uStringsBytes = (juce::uint32) strings.getDataSize();
+    header.uTotalBytes = header.uStringsOffset + header.uStringsBytes;
+    
+    destData.reset();
+    
+    {
+        juce::MemoryOutputStream stream(destData, false);
+        stream.write(&header, sizeof(header));
+        
+        PadTo(stream, header.uScalesOffset);
+        WriteRecords<SCALES_OCTAVE_STEPS>(stream, m_scales, iNumScaleIds);
+        
+        PadTo(stream, header.uChordsOffset);
+        WriteRecords<CHORD_MAX_NOTES>(stream, m_chords, iNumChordIds);
+        
+        PadTo(stream, header.uScaleNamesOffset);
+        WriteNameOffsets(stream, m_scales, iNumScaleIds, scaleNameOffsets);
+        
+        PadTo(stream, header.uChordNamesOffset);
+        WriteNameOffsets(stream, m_chords, iNumChordIds, chordNameOffsets);
+        
+        PadTo(stream, header.uStringsOffset);
+        stream.write(strings.getData(), strings.getDataSize());
+    }
+    
+    return ScaleLibrary::IsValidLibrary(destData.getData(), destData.getSize());
+}
+
+template <int MaxSteps>
+void ScaleLibraryCompiler::WriteRecords(juce::OutputStream& stream, const juce::Array<Entry>& entries, int iNumIds)
+{
+    for(int iId = 0; iId < iNumIds; iId++)
+    {
+        // Zeroed so unused IDs are empty sets and padding bytes are deterministic
+        IntervalSet<MaxSteps> record;
+        juce::zerostruct(record);
+        
+        for(const Entry& entry : entries)
+        {
+            if(entry.iId != iId)
+                continue;
+            
+            for(int iStep : entry.intervals)
+            {
+                record.mask |= 1u << iStep;
+                record.steps[record.numSteps++] = (juce::uint8) iStep;
+            }
+        }
+        
+        stream.write(&record, sizeof(record));
+    }
+}
+
+void ScaleLibraryCompiler::WriteNameOffsets(juce::OutputStream& stream, const juce::Array<Entry>& entries, int iNumIds, const juce::Array<juce::uint32>& nameOffsets)
+{
+    for(int iId = 0; iId < iNumIds; iId++)
+    {
+        juce::uint32 uOffset = 0;
+        
+        for(int i=0; i<entries.size(); i++)
+        {
+            if(entries.getReference(i).iId == iId)
+                uOffset = nameOffsets[i];
+        }
+        
+        stream.write(&uOffset, sizeof(uOffset));
+    }
+}
+
+int ScaleLibraryCompiler::GetNumIds(const juce::Array<Entry>& entries)
+{
+    int iMaxId = 0;
+    for(const Entry& entry : entries)
+        iMaxId = juce::jmax(iMaxId, entry.iId);
+    
+    return iMaxId + 1;
+}
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    ScaleLibraryCompiler.h
+    Created: 17 Oct 2026 6:48:22pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../MidiScalesPlugin/Source/ScaleLibraryFormat.h"
+
+// Compiles the text scale/chord source (see Content/ScaleLibrary.txt) into the packed
+// binary library the plugin memory maps. All the text handling happens here, so the
+// plugin never parses anything when it loads.
+//
+// Source lines:  <scale|chord> | <id> | <intervals ascending from 0> | <name>
+// Blank lines and lines starting with # are ignored.
+class ScaleLibraryCompiler
+{
+public:
+    ScaleLibraryCompiler();
+    ~ScaleLibraryCompiler();
+    
+    // Replaces the current entries. Returns false with one message per bad line if anything is invalid.
+    bool Parse(const juce::String& sourceText, juce::StringArray& errors);
+    
+    // Packs the parsed entries, returns false if the result doesn't pass the plugin's own validation
+    bool Write(juce::MemoryBlock& destData) const;
+    
+    int GetNumScales() const { return m_scales.size(); }
+    int GetNumChords() const { return m_chords.size(); }
+    
+private:
+    struct Entry
+    {
+        int iId;
+        juce::Array<int> intervals;
+        juce::String name;
+    };
+    
+    static bool ParseLine(const juce::String& line, bool& bIsScale, Entry& entry, juce::String& error);
+    
+    template <int MaxSteps>
+    static void WriteRecords(juce::OutputStream& stream, const juce::Array<Entry>& entries, int iNumIds);
+    static void WriteNameOffsets(juce::OutputStream& stream, const juce::Array<Entry>& entries, int iNumIds, const juce::Array<juce::uint32>& nameOffsets);
+    static int GetNumIds(const juce::Array<Entry>& entries);
+    
+    juce::Array<Entry> m_scales;
+    juce::Array<Entry> m_chords;
+    
+    JUCE_DECLARE_NON_COPYABLE (ScaleLibraryCompiler)
+};
@@ -0,0 +1,247 @@
+/*
+  ==============================================================================
+
+    Arpeggiator.cpp
+    Created: 17 Oct 2026 11:48:52pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "Arpeggiator.h"
+
+// Scheduler voice of every arpeggiated note, past all PressedChord::GetSourceId() values.
+// A step repeating the note of the step before re-articulates it.
+static const int s_iArpeggiatorSource = (MIDI_CHANNELS + 1) * SCALES_TOTAL_STEPS;
+
+// Grid positions this close to a step are on it, the host's quarter notes are rounded
+static const double s_dStepTolerance = 1.0e-9;
+
+Arpeggiator::Arpeggiator()
+{
+    m_dSampleRate = 44100.0;
+    m_dStepQuarterNotes = 0.0;
+    SetArpeggio(Arpeggio::Pattern::Up, Arpeggio::Rate::Sixteenth, ARPEGGIATOR_DEFAULT_GATE * 0.01f);
+    Prepare(m_dSampleRate);
+}
+
+Arpeggiator::~Arpeggiator()
+{
+}
+
+void Arpeggiator::Prepare(double dSampleRate)
+{
+    m_dSampleRate = dSampleRate;
+    
+    m_iBlockStartSample = 0;
+    m_dBlockStartQuarterNotes = 0.0;
+    m_dQuarterNotesPerSample = ARPEGGIATOR_DEFAULT_BPM / (60.0 * m_dSampleRate);
+    m_dNextBlockQuarterNotes = 0.0;
+    m_iNextStep = 0;
+    m_bGridPlaced = false;
+    
+    m_iNumHeldNotes = 0;
+    m_iNumPatternNotes = 0;
+    m_uPatternStep = 0;
+}
+
+void Arpeggiator::SetArpeggio(Arpeggio::Pattern::ePattern pattern, Arpeggio::Rate::eRate rate, float fGate)
+{
+    const double dStepQuarterNotes = Helpers::GetArpRateQuarterNotes(rate);
+    
+    // Step numbers count the old step length
+    if(dStepQuarterNotes != m_dStepQuarterNotes)
+        m_bGridPlaced = false;
+    
+    m_pattern = pattern;
+    m_dStepQuarterNotes = dStepQuarterNotes;
+    m_fGate = juce::jlimit(0.0f, 1.0f, fGate);
+}
+
+void Arpeggiator::BeginBlock(const juce::AudioPlayHead::CurrentPositionInfo* pPosition, juce::int64 iBlockStartSample, int iNumSamples)
+{
+    double dBpm = m_dQuarterNotesPerSample * 60.0 * m_dSampleRate;
+    double dBlockStartQuarterNotes = m_dNextBlockQuarterNotes;
+    
+    if(pPosition != nullptr)
+    {
+        if(pPosition->bpm > 0.0)
+            dBpm = juce::jmin(pPosition->bpm, ARPEGGIATOR_MAX_BPM);
+        
+        if(pPosition->isPlaying)
+            dBlockStartQuarterNotes = pPosition->ppqPosition;
+    }
+    
+    // Anything further off than half a step is a loop, a locate or the transport starting, not
+    // rounding or a tempo ramp, and the grid is found again from the new position
+    if(!m_bGridPlaced || std::abs(dBlockStartQuarterNotes - m_dNextBlockQuarterNotes) > 0.5 * m_dStepQuarterNotes)
+    {
+        m_iNextStep = (juce::int64) std::ceil(dBlockStartQuarterNotes / m_dStepQuarterNotes - s_dStepTolerance);
+        m_bGridPlaced = true;
+    }
+    
+    m_iBlockStartSample = iBlockStartSample;
+    m_dBlockStartQuarterNotes = dBlockStartQuarterNotes;
+    m_dQuarterNotesPerSample = dBpm / (60.0 * m_dSampleRate);
+    m_dNextBlockQuarterNotes = dBlockStartQuarterNotes + iNumSamples * m_dQuarterNotesPerSample;
+}
+
+int Arpeggiator::RenderSteps(juce::int64 iSampleTime, MidiNoteScheduler& noteScheduler)
+{
+    int iNumNotes = 0;
+    
+    for(;; m_iNextStep++)
+    {
+        // A step the previous block rounded past its end starts at the top of this one
+        const juce::int64 iStepTime = juce::jmax(GetStepSampleTime(m_iNextStep), m_iBlockStartSample);
+        if(iStepTime >= iSampleTime)
+            break;
+        
+        if(m_iNumPatternNotes == 0)
+            continue;
+        
+        const HeldNote& note = GetPatternNote();
+        m_uPatternStep++;
+        
+        // The gate at this block's tempo, never running into the next step
+        const juce::int64 iStepSamples = GetStepSampleTime(m_iNextStep + 1) - iStepTime;
+        const juce::int64 iGateSamples = juce::jmax((juce::int64) 1, (juce::int64) (m_fGate * iStepSamples));
+        
+        if(noteScheduler.ScheduleNoteOn(iStepTime, note.uChannel, note.uNote, note.uVelocity, s_iArpeggiatorSource))
+        {
+            noteScheduler.ScheduleNoteOff(iStepTime + iGateSamples, note.uChannel, note.uNote, s_iArpeggiatorSource);
+            iNumNotes++;
+        }
+    }
+    
+    return iNumNotes;
+}
+
+void Arpeggiator::AddChord(const PressedChord& chord)
+{
+    const VoicedChord& voicedChord = chord.GetVoicedChord();
+    jassert(m_iNumHeldNotes + voicedChord.size() <= CHORD_MAX_VOICES * CHORD_MAX_NOTES);
+    
+    if(m_iNumHeldNotes + voicedChord.size() > CHORD_MAX_VOICES * CHORD_MAX_NOTES)
+        return;
+    
+    // A new arpeggio starts from the top of its pattern
+    if(m_iNumHeldNotes == 0)
+        m_uPatternStep = 0;
+    
+    for(int i = 0; i < voicedChord.size(); i++)
+    {
+        HeldNote& note = m_heldNotes[m_iNumHeldNotes++];
+        note.iSource = (juce::int16) chord.GetSourceId();
+        note.uChannel = chord.GetToneChannels()[i];
+        note.uNote = voicedChord.notes[i];
+        note.uVelocity = chord.GetVelocity();
+    }
+    
+    UpdatePatternNotes();
+}
+
+bool Arpeggiator::RemoveChord(const PressedChord& chord)
+{
+    const int iSource = chord.GetSourceId();
+    
+    int iFirst = 0;
+    while(iFirst < m_iNumHeldNotes && m_heldNotes[iFirst].iSource != iSource)
+        iFirst++;
+    
+    if(iFirst == m_iNumHeldNotes)
+        return false;
+    
+    // Only this chord's notes, a chord restarted on the same root can follow right after it
+    const int iLast = juce::jmin(iFirst + chord.GetVoicedChord().size(), m_iNumHeldNotes);
+    
+    for(int i = iLast; i < m_iNumHeldNotes; i++)
+        m_heldNotes[iFirst + i - iLast] = m_heldNotes[i];
+    
+    m_iNumHeldNotes -= iLast - iFirst;
+    
+    UpdatePatternNotes();
+    return true;
+}
+
+int Arpeggiator::GetMaxStepsPerBlock(double dSampleRate, int iSamplesPerBlock)
+{
+    double dShortestStep = Helpers::GetArpRateQuarterNotes((Arpeggio::Rate::eRate) 0);
+    for(int i = 1; i < Arpeggio::Rate::Total; i++)
+        dShortestStep = juce::jmin(dShortestStep, Helpers::GetArpRateQuarterNotes((Arpeggio::Rate::eRate) i));
+    
+    const double dShortestStepSamples = dShortestStep * 60.0 / ARPEGGIATOR_MAX_BPM * dSampleRate;
+    return (int) std::ceil(iSamplesPerBlock / dShortestStepSamples) + 1;
+}
+
+void Arpeggiator::UpdatePatternNotes()
+{
+    // Bit per note, per channel
+    juce::uint64 usedNotes[MIDI_CHANNELS][SCALES_TOTAL_STEPS / 64] = {};
+    m_iNumPatternNotes = 0;
+    
+    for(int i = 0; i < m_iNumHeldNotes; i++)
+    {
+        const HeldNote& note = m_heldNotes[i];
+        juce::uint64& uUsedBits = usedNotes[(note.uChannel - 1) % MIDI_CHANNELS][note.uNote / 64];
+        const juce::uint64 uNoteBit = (juce::uint64) 1 << (note.uNote % 64);
+        
+        if(uUsedBits & uNoteBit)
+            continue;
+        
+        uUsedBits |= uNoteBit;
+        m_playedNotes[m_iNumPatternNotes] = note;
+        
+        // Insertion sort, by note then channel
+        int iPosition = m_iNumPatternNotes;
+        for(; iPosition > 0; iPosition--)
+        {
+            const HeldNote& previousNote = m_ascendingNotes[iPosition - 1];
+            if(previousNote.uNote < note.uNote || (previousNote.uNote == note.uNote && previousNote.uChannel < note.uChannel))
+                break;
+            
+            m_ascendingNotes[iPosition] = previousNote;
+        }
+        
+        m_ascendingNotes[iPosition] = note;
+        m_iNumPatternNotes++;
+    }
+}
+
+const Arpeggiator::HeldNote& Arpeggiator::GetPatternNote()
+{
+    const int iNumNotes = m_iNumPatternNotes;
+    const int iStep = (int) (m_uPatternStep % (juce::uint32) iNumNotes);
+    
+    switch(m_pattern)
+    {
+        case Arpeggio::Pattern::Down:
+            return m_ascendingNotes[iNumNotes - 1 - iStep];
+        
+        case Arpeggio::Pattern::UpDown:
+        {
+            if(iNumNotes < 2)
+                return m_ascendingNotes[0];
+            
+            const int iCycleSteps = 2 * iNumNotes - 2;
+            const int iCycleStep = (int) (m_uPatternStep % (juce::uint32) iCycleSteps);
+            return m_ascendingNotes[iCycleStep < iNumNotes ? iCycleStep : iCycleSteps - iCycleStep];
+        }
+        
+        case Arpeggio::Pattern::Random:
+            return m_ascendingNotes[m_random.nextInt(iNumNotes)];
+        
+        case Arpeggio::Pattern::AsPlayed:
+            return m_playedNotes[iStep];
+        
+        case Arpeggio::Pattern::Up:
+        default:
+            return m_ascendingNotes[iStep];
+    }
+}
+
+juce::int64 Arpeggiator::GetStepSampleTime(juce::int64 iStep) const
+{
+    const double dSamples = (iStep * m_dStepQuarterNotes - m_dBlockStartQuarterNotes) / m_dQuarterNotesPerSample;
+    return m_iBlockStartSample + (juce::int64) std::floor(dSamples + 0.5);
+}
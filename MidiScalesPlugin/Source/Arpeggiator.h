@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    Arpeggiator.h
+    Created: 17 Oct 2026 11:48:37pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+#include "MidiNoteScheduler.h"
+#include "PressedChord.h"
+
+// Plays the notes of the held chords one at a time, on a grid of quarter note subdivisions.
+// The grid is placed from the playhead position read once per block: each step's sample is
+// worked out from its quarter note position, so steps stay sample-accurate at any block size,
+// and tempo changes and transport jumps take effect from the next block. Without a playing
+// transport the arpeggiator runs on from where the host left off, at the host's tempo if it
+// reports one. Only Prepare() is not for the audio thread.
+class Arpeggiator
+{
+public:
+    Arpeggiator();
+    ~Arpeggiator();
+    
+    // Forgets the held notes and where the grid is
+    void Prepare(double dSampleRate);
+    
+    // Set once per block. fGate is how much of a step each note sounds for (0-1).
+    void SetArpeggio(Arpeggio::Pattern::ePattern pattern, Arpeggio::Rate::eRate rate, float fGate);
+    
+    // Places the block on the grid, pPosition is nullptr when the host has no playhead
+    void BeginBlock(const juce::AudioPlayHead::CurrentPositionInfo* pPosition, juce::int64 iBlockStartSample, int iNumSamples);
+    // Schedules the steps of this block that start before iSampleTime (absolute), returns the number of
+    // notes started. Called up to each input event, so every step plays the chords held at its time.
+    int RenderSteps(juce::int64 iSampleTime, MidiNoteScheduler& noteScheduler);
+    
+    void AddChord(const PressedChord& chord);
+    // Returns false if the chord isn't being arpeggiated
+    bool RemoveChord(const PressedChord& chord);
+    
+    // Most steps that can start in one block, at ARPEGGIATOR_MAX_BPM and the shortest rate
+    static int GetMaxStepsPerBlock(double dSampleRate, int iSamplesPerBlock);
+    
+private:
+    struct HeldNote
+    {
+        juce::int16 iSource;        // PressedChord::GetSourceId() of the chord it belongs to
+        juce::uint8 uChannel;
+        juce::uint8 uNote;
+        juce::uint8 uVelocity;
+    };
+    
+    // Rebuilds the notes the patterns step through, each channel + note only once
+    void UpdatePatternNotes();
+    const HeldNote& GetPatternNote();
+    juce::int64 GetStepSampleTime(juce::int64 iStep) const;
+    
+    double m_dSampleRate;
+    
+    Arpeggio::Pattern::ePattern m_pattern;
+    double m_dStepQuarterNotes;
+    float m_fGate;
+    
+    // The current block on the grid
+    juce::int64 m_iBlockStartSample;
+    double m_dBlockStartQuarterNotes;
+    double m_dQuarterNotesPerSample;
+    // Where the next block starts if the transport runs on, a host position anywhere else is a jump
+    double m_dNextBlockQuarterNotes;
+    // Next step to play, step N starts N x m_dStepQuarterNotes quarter notes into the timeline
+    juce::int64 m_iNextStep;
+    // False until the first block and after the rate changes, the next block finds its step on the grid again
+    bool m_bGridPlaced;
+    
+    // Notes of the arpeggiated chords in the order they started, each chord's notes together
+    HeldNote m_heldNotes[CHORD_MAX_VOICES * CHORD_MAX_NOTES];
+    int m_iNumHeldNotes;
+    HeldNote m_playedNotes[CHORD_MAX_VOICES * CHORD_MAX_NOTES];
+    HeldNote m_ascendingNotes[CHORD_MAX_VOICES * CHORD_MAX_NOTES];
+    int m_iNumPatternNotes;
+    // Notes played since the arpeggio started, the position in the pattern
+    juce::uint32 m_uPatternStep;
+    juce::Random m_random;
+    
+    JUCE_DECLARE_NON_COPYABLE (Arpeggiator)
+};
@@ -220,6 +220,11 @@ Rectangle<float> BaseKeyboardComponent::getRectangleForKey (int note) const
 {
     jassert (note >= rangeStart && note <= rangeEnd);
     
+    return keyRectangles[note];
+}
+
+Rectangle<float> BaseKeyboardComponent::calculateRectangleForKey (int note) const
+{
     auto pos = getKeyPos (note);
     auto x = pos.getStart();
     auto w = pos.getLength();
@@ -343,6 +348,9 @@ void BaseKeyboardComponent::paint (Graphics& g)
 {
     g.fillAll (findColour (whiteNoteColourId));
     
+    // Key changes only repaint their own rectangles, skip the keys outside of them
+    auto clipBounds = g.getClipBounds().toFloat();
+    
     auto lineColour = findColour (keySeparatorLineColourId);
     auto textColour = findColour (textLabelColourId);
     
@@ -352,8 +360,13 @@ void BaseKeyboardComponent::paint (Graphics& g)
         {
             auto noteNum = octave + keyboard_whiteNotes[white];
             
-            if (noteNum >= rangeStart && noteNum <= rangeEnd)
-                drawWhiteNote (noteNum, g, getRectangleForKey (noteNum),
+            if (noteNum < rangeStart || noteNum > rangeEnd)
+                continue;
+            
+            auto keyArea = getRectangleForKey (noteNum);
+            
+            if (keyArea.intersects (clipBounds))
+                drawWhiteNote (noteNum, g, keyArea,
                                state.isNoteOnForChannels (midiInChannelMask, noteNum),
                                mouseOverNotes.contains (noteNum), lineColour, textColour);
         }
@@ -410,8 +423,13 @@ void BaseKeyboardComponent::paint (Graphics& g)
         {
             auto noteNum = octave + keyboard_blackNotes[black];
             
-            if (noteNum >= rangeStart && noteNum <= rangeEnd)
-                drawBlackNote (noteNum, g, getRectangleForKey (noteNum),
+            if (noteNum < rangeStart || noteNum > rangeEnd)
+                continue;
+            
+            auto keyArea = getRectangleForKey (noteNum);
+            
+            if (keyArea.intersects (clipBounds))
+                drawBlackNote (noteNum, g, keyArea,
                                state.isNoteOnForChannels (midiInChannelMask, noteNum),
                                mouseOverNotes.contains (noteNum), blackNoteColour);
         }
@@ -646,6 +664,14 @@ void BaseKeyboardComponent::resized()
         scrollUp->setVisible (canScroll && getKeyPos (rangeEnd).getStart() > (float) w);
         repaint();
     }
+    
+    updateKeyRectangles();
+}
+
+void BaseKeyboardComponent::updateKeyRectangles()
+{
+    for (int note = rangeStart; note <= rangeEnd; ++note)
+        keyRectangles[note] = calculateRectangleForKey (note);
 }
 
 //==============================================================================
@@ -796,22 +822,43 @@ void BaseKeyboardComponent::timerCallback()
     {
         shouldCheckState = false;
         
-        for (int i = rangeStart; i <= rangeEnd; ++i)
+        // Keys are drawn differently depending on which channels they are down on (chord
+        // notes vs the pressed root note), so the snapshot holds each key's channels rather
+        // than a single down/up bit. Only the keys that differ from it get repainted.
+        RectangleList<int> dirtyKeys;
+        
+        for (int i = 0; i < 128; ++i)
         {
-            bool isOn = state.isNoteOnForChannels (midiInChannelMask, i);
+            auto channelsDown = getChannelsDownForNote (i);
             
-            // MN_JUCE_HACK: Undesirable functionality here blocking paint calls at appropriate timings
-            // due to chord presses. Consider copying this entire class into project for custom use,
-            // rather than relying on JUCE in this case
-            //if (keysCurrentlyDrawnDown[i] != isOn)
+            if (keyChannelsDrawnDown[i] != channelsDown)
             {
-                keysCurrentlyDrawnDown.setBit (i, isOn);
-                repaintNote (i);
+                keyChannelsDrawnDown[i] = channelsDown;
+                
+                if (i >= rangeStart && i <= rangeEnd)
+                    dirtyKeys.add (getRectangleForKey (i).getSmallestIntegerContainer());
             }
         }
+        
+        // A chord's neighbouring keys merge into as few regions as possible
+        dirtyKeys.consolidate();
+        
+        for (auto& area : dirtyKeys)
+            repaint (area);
     }
 }
 
+uint16 BaseKeyboardComponent::getChannelsDownForNote (int midiNoteNumber) const
+{
+    uint16 channelsDown = 0;
+    
+    for (int channel = 1; channel <= 16; ++channel)
+        if ((midiInChannelMask & (1 << (channel - 1))) != 0 && state.isNoteOn (channel, midiNoteNumber))
+            channelsDown |= (uint16) (1 << (channel - 1));
+    
+    return channelsDown;
+}
+
 //==============================================================================
 void BaseKeyboardComponent::clearKeyMappings()
 {
@@ -383,7 +383,9 @@ protected:
      */
     virtual Range<float> getKeyPosition (int midiNoteNumber, float keyWidth) const;
     
-    /** Returns the rectangle for a given key if within the displayable range */
+    /** Returns the rectangle for a given key if within the displayable range.
+        These are cached, and only recalculated when the layout changes in resized().
+     */
     Rectangle<float> getRectangleForKey (int midiNoteNumber) const;
     
     
@@ -403,7 +405,9 @@ private:
     float velocity = 1.0f;
     
     Array<int> mouseOverNotes, mouseDownNotes;
-    BigInteger keysPressed, keysCurrentlyDrawnDown;
+    BigInteger keysPressed;
+    uint16 keyChannelsDrawnDown[128] = {};     // Channels each key was last drawn down on
+    Rectangle<float> keyRectangles[128];
     bool shouldCheckState = false;
     
     int rangeStart = 0, rangeEnd = 127;
@@ -422,6 +426,9 @@ private:
     void updateNoteUnderMouse (Point<float>, bool isDown, int fingerNum);
     void updateNoteUnderMouse (const MouseEvent&, bool isDown);
     void repaintNote (int midiNoteNumber);
+    uint16 getChannelsDownForNote (int midiNoteNumber) const;
+    Rectangle<float> calculateRectangleForKey (int midiNoteNumber) const;
+    void updateKeyRectangles();
     void setLowestVisibleKeyFloat (float noteNumber);
     
 #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
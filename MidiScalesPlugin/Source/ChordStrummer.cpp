@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    ChordStrummer.cpp
+    Created: 17 Oct 2026 11:36:21pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ChordStrummer.h"
+
+ChordStrummer::ChordStrummer()
+{
+    m_dSampleRate = 44100.0;
+    m_bNextStrumDown = false;
+    SetStrum(0.0f, Strum::Direction::Up, 0.0f, 0.0f);
+}
+
+ChordStrummer::~ChordStrummer()
+{
+}
+
+void ChordStrummer::Prepare(double dSampleRate)
+{
+    m_dSampleRate = dSampleRate;
+    m_bNextStrumDown = false;
+}
+
+void ChordStrummer::SetStrum(float fStrumMs, Strum::Direction::eDirection strumDirection, float fVelocityCurve, float fHumanize)
+{
+    m_dStrumSamples = juce::jlimit(0.0f, (float) STRUM_MAX_NOTE_MS, fStrumMs) * 0.001 * m_dSampleRate;
+    m_strumDirection = strumDirection;
+    m_fVelocityCurve = juce::jlimit(-1.0f, 1.0f, fVelocityCurve);
+    
+    fHumanize = juce::jlimit(0.0f, 1.0f, fHumanize);
+    m_dHumanizeSamples = fHumanize * STRUM_MAX_HUMANIZE_MS * 0.001 * m_dSampleRate;
+    m_fHumanizeVelocity = fHumanize * STRUM_MAX_HUMANIZE_VELOCITY;
+}
+
+void ChordStrummer::Strum(int iNumNotes, juce::uint8 uVelocity, StrummedNotes& strummedNotes)
+{
+    bool bDown = m_strumDirection == Strum::Direction::Down;
+    if(m_strumDirection == Strum::Direction::Alternate)
+    {
+        bDown = m_bNextStrumDown;
+        m_bNextStrumDown = !m_bNextStrumDown;
+    }
+    
+    for(int i = 0; i < iNumNotes; i++)
+    {
+        // Position of the note in the strum, 0 sounds first
+        const int iStrumIndex = bDown ? iNumNotes - 1 - i : i;
+        
+        double dOffset = iStrumIndex * m_dStrumSamples;
+        float fVelocity = uVelocity;
+        
+        if(iNumNotes > 1)
+            fVelocity *= 1.0f + m_fVelocityCurve * (float) iStrumIndex / (float) (iNumNotes - 1);
+        
+        if(m_dHumanizeSamples > 0.0)
+        {
+            dOffset += m_random.nextDouble() * m_dHumanizeSamples;
+            fVelocity *= 1.0f + m_fHumanizeVelocity * (2.0f * m_random.nextFloat() - 1.0f);
+        }
+        
+        strummedNotes.offsets[i] = (juce::int32) juce::roundToInt(dOffset);
+        strummedNotes.velocities[i] = (juce::uint8) juce::jlimit(1, 127, juce::roundToInt(fVelocity));
+    }
+}
+
+int ChordStrummer::GetMaxStrumSamples(double dSampleRate)
+{
+    const int iMaxStrumMs = STRUM_MAX_NOTE_MS * (CHORD_MAX_NOTES - 1) + STRUM_MAX_HUMANIZE_MS;
+    return (int) std::ceil(iMaxStrumMs * 0.001 * dSampleRate);
+}
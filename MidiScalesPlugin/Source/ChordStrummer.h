@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    ChordStrummer.h
+    Created: 17 Oct 2026 11:36:08pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+
+// When each note of a chord starts and how hard, per note of a VoicedChord (lowest first)
+struct StrummedNotes
+{
+    juce::int32 offsets[CHORD_MAX_NOTES];       // Samples after the chord's note-on, never negative
+    juce::uint8 velocities[CHORD_MAX_NOTES];
+};
+
+// Spreads a chord's note-ons out like a strum, optionally with random timing and velocity.
+// The offsets can run past the end of the block, the MidiNoteScheduler carries them into the
+// following blocks. Everything but Prepare() is safe on the audio thread.
+class ChordStrummer
+{
+public:
+    ChordStrummer();
+    ~ChordStrummer();
+    
+    void Prepare(double dSampleRate);
+    
+    // Set once per block. fVelocityCurve scales the last strummed note's velocity by 1 + fVelocityCurve,
+    // the notes in between are interpolated. fHumanize (0-1) scales the humanize limits.
+    void SetStrum(float fStrumMs, Strum::Direction::eDirection strumDirection, float fVelocityCurve, float fHumanize);
+    
+    void Strum(int iNumNotes, juce::uint8 uVelocity, StrummedNotes& strummedNotes);
+    
+    // Longest a strummed chord can take to start all of its notes
+    static int GetMaxStrumSamples(double dSampleRate);
+    
+private:
+    double m_dSampleRate;
+    
+    double m_dStrumSamples;
+    Strum::Direction::eDirection m_strumDirection;
+    float m_fVelocityCurve;
+    double m_dHumanizeSamples;
+    float m_fHumanizeVelocity;
+    
+    // Direction of the next chord for Strum::Direction::Alternate
+    bool m_bNextStrumDown;
+    juce::Random m_random;
+    
+    JUCE_DECLARE_NON_COPYABLE (ChordStrummer)
+};
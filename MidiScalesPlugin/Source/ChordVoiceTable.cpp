@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    ChordVoiceTable.cpp
+    Created: 17 Oct 2026 11:03:02am
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ChordVoiceTable.h"
+
+ChordVoiceTable::ChordVoiceTable()
+{
+    Reset();
+}
+
+ChordVoiceTable::~ChordVoiceTable()
+{
+}
+
+void ChordVoiceTable::Reset()
+{
+    for(int i=0; i<CHORD_MAX_VOICES; i++)
+    {
+        m_chords[i].Reset();
+        m_uChordStartOrder[i] = 0;
+        m_iSlotRootNote[i] = -1;
+        m_iSlotChannel[i] = -1;
+    }
+    
+    std::memset(m_chordSlots, -1, sizeof(m_chordSlots));
+    std::memset(m_channelSlots, -1, sizeof(m_channelSlots));
+    m_uNextStartOrder = 0;
+    m_iNumActiveChords = 0;
+}
+
+bool ChordVoiceTable::IsValidKey(int iRootNote, int iChannel)
+{
+    return iRootNote >= 0 && iRootNote < SCALES_TOTAL_STEPS && iChannel >= 1 && iChannel <= MIDI_CHANNELS;
+}
+
+int ChordVoiceTable::GetSlotIndex(const PressedChord& chord) const
+{
+    const int iSlot = (int) (&chord - m_chords);
+    jassert(iSlot >= 0 && iSlot < CHORD_MAX_VOICES);
+    return iSlot;
+}
+
+PressedChord* ChordVoiceTable::FindChord(int iRootNote, int iChannel)
+{
+    if(!IsValidKey(iRootNote, iChannel))
+        return nullptr;
+    
+    const int iSlot = m_chordSlots[iChannel - 1][iRootNote];
+    return iSlot >= 0 ? &m_chords[iSlot] : nullptr;
+}
+
+PressedChord* ChordVoiceTable::FindChannelChord(int iChannel)
+{
+    if(iChannel < 1 || iChannel > MIDI_CHANNELS)
+        return nullptr;
+    
+    const int iSlot = m_channelSlots[iChannel - 1];
+    return iSlot >= 0 ? &m_chords[iSlot] : nullptr;
+}
+
+PressedChord& ChordVoiceTable::AddChord(int iRootNote, int iChannel)
+{
+    jassert(IsValidKey(iRootNote, iChannel));
+    jassert(FindChord(iRootNote, iChannel) == nullptr);
+    jassert(!IsFull());
+    
+    int iSlot = 0;
+    while(iSlot < CHORD_MAX_VOICES - 1 && IsSlotInUse(iSlot))
+        iSlot++;
+    
+    m_chordSlots[iChannel - 1][iRootNote] = (juce::int8) iSlot;
+    m_channelSlots[iChannel - 1] = (juce::int8) iSlot;
+    m_iSlotRootNote[iSlot] = iRootNote;
+    m_iSlotChannel[iSlot] = iChannel;
+    m_uChordStartOrder[iSlot] = m_uNextStartOrder++;
+    m_iNumActiveChords++;
+    
+    m_chords[iSlot].SetHeldKey(iRootNote, iChannel);
+    return m_chords[iSlot];
+}
+
+void ChordVoiceTable::RemoveChord(PressedChord& chord)
+{
+    const int iSlot = GetSlotIndex(chord);
+    
+    if(IsSlotInUse(iSlot))
+    {
+        m_chordSlots[m_iSlotChannel[iSlot] - 1][m_iSlotRootNote[iSlot]] = -1;
+        if(m_channelSlots[m_iSlotChannel[iSlot] - 1] == iSlot)
+            m_channelSlots[m_iSlotChannel[iSlot] - 1] = -1;
+        m_iSlotRootNote[iSlot] = -1;
+        m_iSlotChannel[iSlot] = -1;
+        m_iNumActiveChords--;
+    }
+    
+    chord.Reset();
+}
+
+PressedChord* ChordVoiceTable::GetOldestChord()
+{
+    PressedChord* pOldest = nullptr;
+    juce::uint32 uOldestAge = 0;
+    
+    for(int i=0; i<CHORD_MAX_VOICES; i++)
+    {
+        if(!IsSlotInUse(i))
+            continue;
+        
+        // Unsigned difference keeps the ordering correct when the counter wraps
+        const juce::uint32 uAge = m_uNextStartOrder - m_uChordStartOrder[i];
+        if(pOldest == nullptr || uAge > uOldestAge)
+        {
+            pOldest = &m_chords[i];
+            uOldestAge = uAge;
+        }
+    }
+    
+    return pOldest;
+}
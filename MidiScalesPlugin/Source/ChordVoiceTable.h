@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    ChordVoiceTable.h
+    Created: 17 Oct 2026 11:02:45am
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+#include "PressedChord.h"
+
+// Fixed capacity set of chords that are currently held down, so overlapping chords
+// can sound together. Chords are looked up by the root note + channel that started
+// them in O(1), nothing here allocates after construction.
+class ChordVoiceTable
+{
+public:
+    ChordVoiceTable();
+    ~ChordVoiceTable();
+    
+    void Reset();
+    
+    // Chord started by this root note on this channel, nullptr if there is none
+    PressedChord* FindChord(int iRootNote, int iChannel);
+    // Latest chord started on this channel that is still held, O(1) for channel messages. An MPE
+    // controller plays one note per channel, so it is the chord the channel's expression belongs to.
+    PressedChord* FindChannelChord(int iChannel);
+    
+    // Takes a free slot for a new chord and keys its scheduler source on iRootNote/iChannel. The table
+    // must not be full and the root note/channel must not already have a chord, see IsFull() and GetOldestChord()
+    PressedChord& AddChord(int iRootNote, int iChannel);
+    void RemoveChord(PressedChord& chord);
+    
+    bool IsFull() const { return m_iNumActiveChords == CHORD_MAX_VOICES; }
+    int GetNumActiveChords() const { return m_iNumActiveChords; }
+    
+    // Chord that has been held the longest, the one to steal when the table is full
+    PressedChord* GetOldestChord();
+    
+    template <typename Callback>
+    void ForEachChord(Callback&& callback)
+    {
+        for(int iSlot = 0; iSlot < CHORD_MAX_VOICES; iSlot++)
+        {
+            if(IsSlotInUse(iSlot))
+                callback(m_chords[iSlot]);
+        }
+    }
+    
+private:
+    static bool IsValidKey(int iRootNote, int iChannel);
+    int GetSlotIndex(const PressedChord& chord) const;
+    
+    bool IsSlotInUse(int iSlot) const { return m_iSlotRootNote[iSlot] >= 0; }
+    
+    PressedChord m_chords[CHORD_MAX_VOICES];
+    juce::uint32 m_uChordStartOrder[CHORD_MAX_VOICES];
+    // Key each slot was added under, root note is -1 for free slots
+    int m_iSlotRootNote[CHORD_MAX_VOICES];
+    int m_iSlotChannel[CHORD_MAX_VOICES];
+    // Slot index per [channel][root note], -1 when no chord is held
+    juce::int8 m_chordSlots[MIDI_CHANNELS][SCALES_TOTAL_STEPS];
+    // Slot per channel of the latest chord started on it, -1 when it has ended
+    juce::int8 m_channelSlots[MIDI_CHANNELS];
+    juce::uint32 m_uNextStartOrder;
+    int m_iNumActiveChords;
+};
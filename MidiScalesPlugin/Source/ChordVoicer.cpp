@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    ChordVoicer.cpp
+    Created: 17 Oct 2026 10:41:37pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ChordVoicer.h"
+#include "ScaleLibrary.h"
+
+// Rounds towards negative infinity, unlike /
+static int FloorDivide(int iValue, int iDivisor)
+{
+    return iValue >= 0 ? iValue / iDivisor : -((-iValue + iDivisor - 1) / iDivisor);
+}
+
+ChordInversionTable::ChordInversionTable()
+{
+    const ScaleLibrary& scaleLibrary = ScaleLibrary::GetInstance();
+    
+    m_iNumChordTypes = scaleLibrary.GetNumChords();
+    m_chordTypeInversions.calloc((size_t) m_iNumChordTypes);
+    
+    for(int i = 0; i < m_iNumChordTypes; i++)
+        ChordVoicer::BuildInversions(scaleLibrary.GetChord(i), m_chordTypeInversions[i]);
+}
+
+ChordInversionTable::~ChordInversionTable()
+{
+}
+
+const ChordInversions& ChordInversionTable::GetInversions(Chords::Type::eType chordType) const
+{
+    return m_chordTypeInversions[chordType >= 0 && chordType < m_iNumChordTypes ? chordType : 0];
+}
+
+ChordVoicer::ChordVoicer()
+{
+    SetVoicing(Voicing::Mode::RootPosition, VOICING_DEFAULT_LOW_NOTE, VOICING_DEFAULT_HIGH_NOTE);
+    Reset();
+}
+
+ChordVoicer::~ChordVoicer()
+{
+}
+
+void ChordVoicer::Reset()
+{
+    m_previousChord.numNotes = 0;
+}
+
+void ChordVoicer::SetVoicing(Voicing::Mode::eMode voicingMode, int iLowNote, int iHighNote)
+{
+    m_voicingMode = voicingMode;
+    m_iLowNote = juce::jlimit(0, SCALES_TOTAL_STEPS - 1, iLowNote);
+    m_iHighNote = juce::jlimit(m_iLowNote, SCALES_TOTAL_STEPS - 1, iHighNote);
+}
+
+const ChordInversions& ChordVoicer::GetInversions(Chords::Type::eType chordType) const
+{
+    return m_pInversionTable->GetInversions(chordType);
+}
+
+void ChordVoicer::Voice(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord)
+{
+    if(m_voicingMode == Voicing::Mode::VoiceLeading)
+        VoiceLeading(inversions, iRootNote, voicedChord);
+    else
+        VoiceRootPosition(inversions, iRootNote, voicedChord);
+    
+    if(voicedChord.numNotes > 0)
+        m_previousChord = voicedChord;
+}
+
+void ChordVoicer::BuildInversions(const ChordNotes& chordNotes, ChordInversions& inversions)
+{
+    const int iNumNotes = chordNotes.size();
+    inversions.numNotes = iNumNotes;
+    
+    for(int iInversion = 0; iInversion < iNumNotes; iInversion++)
+    {
+        juce::uint8* pOffsets = inversions.offsets[iInversion];
+        juce::uint64 uUsedOffsets = 0;
+        
+        for(int i = 0; i < iNumNotes; i++)
+        {
+            // Notes below the inversion's bass go up an octave, extended chords can need two
+            int iOffset = chordNotes[(iInversion + i) % iNumNotes];
+            if(iInversion + i >= iNumNotes)
+            {
+                iOffset += SCALES_OCTAVE_STEPS;
+                while((uUsedOffsets >> iOffset) & 1)
+                    iOffset += SCALES_OCTAVE_STEPS;
+            }
+            uUsedOffsets |= (juce::uint64) 1 << iOffset;
+            
+            // Insertion sort, the raised notes can land between the extensions
+            int iPosition = i;
+            for(; iPosition > 0 && pOffsets[iPosition - 1] > iOffset; iPosition--)
+                pOffsets[iPosition] = pOffsets[iPosition - 1];
+            
+            pOffsets[iPosition] = (juce::uint8) iOffset;
+        }
+    }
+}
+
+void ChordVoicer::VoiceRootPosition(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord)
+{
+    VoiceOffsets(inversions.offsets[0], inversions.numNotes, iRootNote, voicedChord);
+}
+
+void ChordVoicer::VoiceRootPosition(const ChordNotes& chordNotes, int iRootNote, VoicedChord& voicedChord)
+{
+    VoiceOffsets(chordNotes.steps, chordNotes.size(), iRootNote, voicedChord);
+}
+
+void ChordVoicer::VoiceOffsets(const juce::uint8* pOffsets, int iNumNotes, int iBaseNote, VoicedChord& voicedChord)
+{
+    voicedChord.numNotes = 0;
+    
+    for(int i = 0; i < iNumNotes; i++)
+    {
+        const int iNote = iBaseNote + pOffsets[i];
+        if(iNote >= SCALES_TOTAL_STEPS)
+            break;
+        
+        voicedChord.notes[voicedChord.numNotes++] = (juce::uint8) iNote;
+    }
+}
+
+void ChordVoicer::VoiceLeading(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord) const
+{
+    const int iNumNotes = inversions.numNotes;
+    
+    // The first chord stays as close to root position on the pressed key as the register allows
+    VoicedChord rootPositionChord;
+    if(m_previousChord.numNotes == 0)
+        VoiceRootPosition(inversions, iRootNote, rootPositionChord);
+    const VoicedChord& previousChord = m_previousChord.numNotes > 0 ? m_previousChord : rootPositionChord;
+    
+    int iBestInversion = -1;
+    int iBestBaseNote = 0;
+    int iBestMovement = std::numeric_limits<int>::max();
+    
+    for(int iInversion = 0; iInversion < iNumNotes; iInversion++)
+    {
+        const juce::uint8* pOffsets = inversions.offsets[iInversion];
+        
+        // Octaves of this inversion that fit the register entirely
+        const int iMinOctave = -FloorDivide(iRootNote + pOffsets[0] - m_iLowNote, SCALES_OCTAVE_STEPS);
+        const int iMaxOctave = FloorDivide(m_iHighNote - (iRootNote + pOffsets[iNumNotes - 1]), SCALES_OCTAVE_STEPS);
+        
+        for(int iOctave = iMinOctave; iOctave <= iMaxOctave; iOctave++)
+        {
+            const int iBaseNote = iRootNote + iOctave * SCALES_OCTAVE_STEPS;
+            const int iMovement = GetMovement(pOffsets, iNumNotes, iBaseNote, previousChord);
+            
+            if(iMovement < iBestMovement)
+            {
+                iBestInversion = iInversion;
+                iBestBaseNote = iBaseNote;
+                iBestMovement = iMovement;
+            }
+        }
+    }
+    
+    if(iBestInversion < 0)
+    {
+        // Wider than the register, keep root position starting as close to the bottom as it can
+        const int iBaseNote = iRootNote + FloorDivide(m_iLowNote - iRootNote + SCALES_OCTAVE_STEPS - 1, SCALES_OCTAVE_STEPS) * SCALES_OCTAVE_STEPS;
+        VoiceRootPosition(inversions, iBaseNote, voicedChord);
+        return;
+    }
+    
+    VoiceOffsets(inversions.offsets[iBestInversion], iNumNotes, iBestBaseNote, voicedChord);
+}
+
+int ChordVoicer::GetMovement(const juce::uint8* pOffsets, int iNumNotes, int iBaseNote, const VoicedChord& previousChord)
+{
+    int iMovement = 0;
+    
+    for(int i = 0; i < iNumNotes; i++)
+    {
+        int iNearest = std::numeric_limits<int>::max();
+        for(int iPreviousNote : previousChord)
+            iNearest = juce::jmin(iNearest, std::abs(iBaseNote + pOffsets[i] - iPreviousNote));
+        
+        iMovement += iNearest;
+    }
+    
+    // Both ways, so a chord can't collapse onto one note of the previous chord
+    for(int iPreviousNote : previousChord)
+    {
+        int iNearest = std::numeric_limits<int>::max();
+        for(int i = 0; i < iNumNotes; i++)
+            iNearest = juce::jmin(iNearest, std::abs(iBaseNote + pOffsets[i] - iPreviousNote));
+        
+        iMovement += iNearest;
+    }
+    
+    return iMovement;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    ChordVoicer.h
+    Created: 17 Oct 2026 10:41:22pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+
+// Output notes of one chord, ascending
+struct VoicedChord
+{
+    juce::uint8 notes[CHORD_MAX_NOTES];
+    int numNotes;
+    
+    int size() const { return numNotes; }
+    const juce::uint8* begin() const { return notes; }
+    const juce::uint8* end() const { return notes + numNotes; }
+};
+
+// Every inversion of a chord shape as ascending offsets from the chord's root note.
+// Inversion 0 is root position, inversion N moves the lowest N notes up an octave.
+struct ChordInversions
+{
+    juce::uint8 offsets[CHORD_MAX_NOTES][CHORD_MAX_NOTES];
+    int numNotes;       // Also the number of inversions
+};
+
+// The inversions of every chord type in the scale library, built by the first ChordVoicer
+// and shared read-only by every plugin instance in the process through a
+// juce::SharedResourcePointer, so further instances cost neither time nor memory however
+// many chord types the library has. Released with the last instance.
+class ChordInversionTable
+{
+public:
+    ChordInversionTable();
+    ~ChordInversionTable();
+    
+    // Unknown types return the empty Invalid entry
+    const ChordInversions& GetInversions(Chords::Type::eType chordType) const;
+    
+private:
+    juce::HeapBlock<ChordInversions> m_chordTypeInversions;
+    int m_iNumChordTypes;
+    
+    JUCE_DECLARE_NON_COPYABLE (ChordInversionTable)
+};
+
+// Places chords in the output register. Voice leading picks the inversion and octave
+// whose notes move the least from the previous chord, out of the precomputed inversions,
+// so a chord costs at most CHORD_MAX_NOTES inversions x 11 octaves to place. Only the
+// first instance's constructor allocates, everything else is safe on the audio thread.
+class ChordVoicer
+{
+public:
+    // Shares the inversions of every chord type, precomputed by the first voicer in the process
+    ChordVoicer();
+    ~ChordVoicer();
+    
+    // Forgets the previous chord, the next one is placed around its root note
+    void Reset();
+    
+    // Set once per block. Voice leading keeps every note between the low and high note.
+    void SetVoicing(Voicing::Mode::eMode voicingMode, int iLowNote, int iHighNote);
+    
+    const ChordInversions& GetInversions(Chords::Type::eType chordType) const;
+    
+    void Voice(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord);
+    
+    static void BuildInversions(const ChordNotes& chordNotes, ChordInversions& inversions);
+    // The chord as written on the root note, notes past the top of the MIDI range are left out
+    static void VoiceRootPosition(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord);
+    static void VoiceRootPosition(const ChordNotes& chordNotes, int iRootNote, VoicedChord& voicedChord);
+    
+private:
+    void VoiceLeading(const ChordInversions& inversions, int iRootNote, VoicedChord& voicedChord) const;
+    static void VoiceOffsets(const juce::uint8* pOffsets, int iNumNotes, int iBaseNote, VoicedChord& voicedChord);
+    // Distance from each note to the nearest note of the other chord, both ways
+    static int GetMovement(const juce::uint8* pOffsets, int iNumNotes, int iBaseNote, const VoicedChord& previousChord);
+    
+    juce::SharedResourcePointer<ChordInversionTable> m_pInversionTable;
+    
+    Voicing::Mode::eMode m_voicingMode;
+    int m_iLowNote;
+    int m_iHighNote;
+    
+    // Last chord voiced, what voice leading moves away from
+    VoicedChord m_previousChord;
+    
+    JUCE_DECLARE_NON_COPYABLE (ChordVoicer)
+};
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    KeyboardStateFifo.cpp
+    Created: 17 Oct 2026 7:13:05pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "KeyboardStateFifo.h"
+
+KeyboardStateFifo::KeyboardStateFifo()
+{
+    m_bAttached.set(0);
+    m_bPublishHeldNotes.set(0);
+    m_bOverflowed.set(0);
+}
+
+KeyboardStateFifo::~KeyboardStateFifo()
+{
+}
+
+void KeyboardStateFifo::Attach()
+{
+    // Only the reader may move the read position, so drop leftovers by reading them
+    m_fifo.finishedRead(m_fifo.getNumReady());
+    m_bOverflowed.set(0);
+    
+    m_bPublishHeldNotes.set(1);
+    m_bAttached.set(1);
+}
+
+void KeyboardStateFifo::Detach()
+{
+    m_bAttached.set(0);
+}
+
+void KeyboardStateFifo::Push(int iChannel, int iNote, juce::uint8 uVelocity) noexcept
+{
+    int iStart1, iSize1, iStart2, iSize2;
+    m_fifo.prepareToWrite(1, iStart1, iSize1, iStart2, iSize2);
+    
+    if(iSize1 + iSize2 < 1)
+    {
+        m_bOverflowed.set(1);
+        return;
+    }
+    
+    Delta& delta = m_fifoDeltas[iSize1 > 0 ? iStart1 : iStart2];
+    delta.uChannel = (juce::uint8) iChannel;
+    delta.uNote = (juce::uint8) iNote;
+    delta.uVelocity = uVelocity;
+    m_fifo.finishedWrite(1);
+}
+
+int KeyboardStateFifo::Drain(juce::MidiKeyboardState& keyboardState)
+{
+    int iStart1, iSize1, iStart2, iSize2;
+    m_fifo.prepareToRead(m_fifo.getNumReady(), iStart1, iSize1, iStart2, iSize2);
+    
+    auto applyDeltas = [this, &keyboardState](int iStart, int iSize)
+    {
+        for(int i = iStart; i < iStart + iSize; i++)
+        {
+            const Delta& delta = m_fifoDeltas[i];
+            
+            if(delta.uVelocity > 0)
+                keyboardState.noteOn(delta.uChannel, delta.uNote, delta.uVelocity / 127.0f);
+            else
+                keyboardState.noteOff(delta.uChannel, delta.uNote, 0.0f);
+        }
+    };
+    
+    applyDeltas(iStart1, iSize1);
+    applyDeltas(iStart2, iSize2);
+    m_fifo.finishedRead(iSize1 + iSize2);
+    
+    // Some changes were lost, rather than leave keys stuck start again from what is held now
+    if(m_bOverflowed.exchange(0) != 0)
+    {
+        keyboardState.allNotesOff(0);
+        m_bPublishHeldNotes.set(1);
+    }
+    
+    return iSize1 + iSize2;
+}
@@ -0,0 +1,57 @@
+/*
+  ==============================================================================
+
+    KeyboardStateFifo.h
+    Created: 17 Oct 2026 7:12:48pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities.h"
+
+// Note on/off changes for the on-screen keyboard, handed from the audio thread to
+// the editor through a lock-free single producer/single consumer FIFO. The audio
+// thread never touches a juce::MidiKeyboardState (its lock and listener list), the
+// editor applies the changes to its own state on the message thread instead.
+// Nothing is queued while no editor is attached.
+class KeyboardStateFifo
+{
+public:
+    struct Delta
+    {
+        juce::uint8 uChannel;
+        juce::uint8 uNote;
+        juce::uint8 uVelocity;      // 0 -> note off
+    };
+    
+    KeyboardStateFifo();
+    ~KeyboardStateFifo();
+    
+    // Reader thread only. Stale changes from a previous reader are dropped, and the
+    // chords that are already held get published again on the next block.
+    void Attach();
+    void Detach();
+    
+    // Audio thread only, checked once per block
+    bool IsAttached() const noexcept { return m_bAttached.get() != 0; }
+    // Audio thread only. True once after the reader asked for the held notes again.
+    bool ShouldPublishHeldNotes() noexcept { return m_bPublishHeldNotes.exchange(0) != 0; }
+    
+    // Audio thread only. Wait free, a full FIFO makes the reader start over.
+    void Push(int iChannel, int iNote, juce::uint8 uVelocity) noexcept;
+    
+    // Reader thread only. Applies the queued changes to the state, returns how many there were
+    int Drain(juce::MidiKeyboardState& keyboardState);
+    
+private:
+    juce::AbstractFifo m_fifo { KEYBOARD_STATE_FIFO_SIZE };
+    Delta m_fifoDeltas[KEYBOARD_STATE_FIFO_SIZE];
+    juce::Atomic<int> m_bAttached;
+    juce::Atomic<int> m_bPublishHeldNotes;
+    juce::Atomic<int> m_bOverflowed;
+    
+    JUCE_DECLARE_NON_COPYABLE (KeyboardStateFifo)
+};
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    MidiNoteScheduler.cpp
+    Created: 17 Oct 2026 8:14:51pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "MidiNoteScheduler.h"
+
+MidiNoteScheduler::MidiNoteScheduler()
+{
+    m_iCapacity = 0;
+    Reset();
+}
+
+MidiNoteScheduler::~MidiNoteScheduler()
+{
+}
+
+void MidiNoteScheduler::Prepare(int iCapacity)
+{
+    if(iCapacity != m_iCapacity)
+    {
+        m_events.malloc((size_t) iCapacity);
+        m_sampleEvents.malloc((size_t) iCapacity);
+        m_iCapacity = iCapacity;
+    }
+    
+    Reset();
+}
+
+void MidiNoteScheduler::Reset()
+{
+    m_iNumEvents = 0;
+    m_uNextOrder = 0;
+    
+    std::memset(m_noteCounts, 0, sizeof(m_noteCounts));
+    std::memset(m_iChannelEvents, 0, sizeof(m_iChannelEvents));
+    std::memset(m_iChannelNotes, 0, sizeof(m_iChannelNotes));
+    std::memset(m_iChannelReleaseTime, 0, sizeof(m_iChannelReleaseTime));
+    std::fill(&m_iPendingNoteOff[0][0], &m_iPendingNoteOff[0][0] + MIDI_CHANNELS * SCALES_TOTAL_STEPS, -1);
+}
+
+bool MidiNoteScheduler::IsLater(const Event& a, const Event& b)
+{
+    return a.iSampleTime != b.iSampleTime ? a.iSampleTime > b.iSampleTime : a.uOrder > b.uOrder;
+}
+
+bool MidiNoteScheduler::IsNoteSounding(int iChannel, int iNote) const
+{
+    return m_noteCounts[iChannel - 1][iNote] > 0;
+}
+
+bool MidiNoteScheduler::IsChannelActive(int iChannel) const
+{
+    return m_iChannelEvents[iChannel - 1] > 0 || m_iChannelNotes[iChannel - 1] > 0;
+}
+
+bool MidiNoteScheduler::ScheduleNoteOn(juce::int64 iSampleTime, int iChannel, int iNote, juce::uint8 uVelocity, int iSource)
+{
+    // Leave enough room to end every chord that could be held. Dense input can reach this
+    // limit, so refusing the note isn't an error.
+    if(m_iNumEvents + CHORD_MAX_VOICES * CHORD_MAX_NOTES >= m_iCapacity)
+        return false;
+    
+    // A velocity of 0 would turn it into a note-off
+    return Schedule(iSampleTime, iChannel, iNote, juce::jmax(uVelocity, (juce::uint8) 1), iSource);
+}
+
+bool MidiNoteScheduler::ScheduleNoteOff(juce::int64 iSampleTime, int iChannel, int iNote, int iSource)
+{
+    if(m_iNumEvents >= m_iCapacity)
+    {
+        jassertfalse;
+        return false;
+    }
+    
+    return Schedule(iSampleTime, iChannel, iNote, 0, iSource);
+}
+
+bool MidiNoteScheduler::Schedule(juce::int64 iSampleTime, int iChannel, int iNote, juce::uint8 uVelocity, int iSource)
+{
+    jassert(iChannel >= 1 && iChannel <= MIDI_CHANNELS && iNote >= 0 && iNote < SCALES_TOTAL_STEPS);
+    
+    // Restart the ordering whenever the queue drains so it never wraps in practice
+    if(m_iNumEvents == 0)
+        m_uNextOrder = 0;
+    
+    Event& event = m_events[m_iNumEvents++];
+    event.iSampleTime = iSampleTime;
+    event.uOrder = m_uNextOrder++;
+    event.iSource = (juce::int16) iSource;
+    event.uChannel = (juce::uint8) iChannel;
+    event.uNote = (juce::uint8) iNote;
+    event.uVelocity = uVelocity;
+    
+    std::push_heap(m_events.get(), m_events.get() + m_iNumEvents, IsLater);
+    m_iChannelEvents[iChannel - 1]++;
+    return true;
+}
+
+void MidiNoteScheduler::RenderBlock(juce::int64 iBlockStart, int iNumSamples, juce::MidiBuffer& outputMidi)
+{
+    const juce::int64 iBlockEnd = iBlockStart + iNumSamples;
+    
+    while(m_iNumEvents > 0 && m_events[0].iSampleTime < iBlockEnd)
+    {
+        // Collect every event due at this sample, then resolve them together
+        const juce::int64 iSampleTime = m_events[0].iSampleTime;
+        int iNumSampleEvents = 0;
+        
+        while(m_iNumEvents > 0 && m_events[0].iSampleTime == iSampleTime)
+        {
+            std::pop_heap(m_events.get(), m_events.get() + m_iNumEvents, IsLater);
+            const Event& event = m_sampleEvents[iNumSampleEvents++] = m_events[--m_iNumEvents];
+            m_iChannelEvents[event.uChannel - 1]--;
+        }
+        
+        // Anything scheduled in the past goes out at the start of the block
+        const int iSamplePosition = (int) juce::jmax((juce::int64) 0, iSampleTime - iBlockStart);
+        RenderSampleEvents(iNumSampleEvents, iSamplePosition, outputMidi);
+    }
+}
+
+void MidiNoteScheduler::RenderSampleEvents(int iNumSampleEvents, int iSamplePosition, juce::MidiBuffer& outputMidi)
+{
+    // A note-on that takes over a note-off of another voice at the same sample leaves
+    // the note sounding, rather than sending a redundant off/on pair
+    for(int i=0; i<iNumSampleEvents; i++)
+    {
+        const Event& event = m_sampleEvents[i];
+        int& iPendingNoteOff = m_iPendingNoteOff[event.uChannel - 1][event.uNote];
+        
+        if(event.uVelocity == 0 && iPendingNoteOff < 0)
+            iPendingNoteOff = i;
+    }
+    
+    for(int i=0; i<iNumSampleEvents; i++)
+    {
+        Event& event = m_sampleEvents[i];
+        if(event.uVelocity == 0)
+            continue;
+        
+        int& iPendingNoteOff = m_iPendingNoteOff[event.uChannel - 1][event.uNote];
+        if(iPendingNoteOff >= 0 && m_sampleEvents[iPendingNoteOff].iSource != event.iSource)
+        {
+            m_sampleEvents[iPendingNoteOff].uChannel = 0;
+            event.uChannel = 0;
+            iPendingNoteOff = -1;
+        }
+    }
+    
+    // Note-offs first, so a voice re-articulating its own note ends it before starting it again
+    for(int i=0; i<iNumSampleEvents; i++)
+    {
+        const Event& event = m_sampleEvents[i];
+        if(event.uVelocity != 0 || event.uChannel == 0)
+            continue;
+        
+        m_iPendingNoteOff[event.uChannel - 1][event.uNote] = -1;
+        
+        juce::uint8& uCount = m_noteCounts[event.uChannel - 1][event.uNote];
+        if(uCount > 0 && --uCount == 0)
+        {
+            const juce::uint8 noteOff[] = { (juce::uint8) (0x80 | (event.uChannel - 1)), event.uNote, 0 };
+            outputMidi.addEvent(noteOff, sizeof(noteOff), iSamplePosition);
+            
+            if(--m_iChannelNotes[event.uChannel - 1] == 0)
+                m_iChannelReleaseTime[event.uChannel - 1] = event.iSampleTime;
+        }
+    }
+    
+    for(int i=0; i<iNumSampleEvents; i++)
+    {
+        const Event& event = m_sampleEvents[i];
+        if(event.uVelocity == 0 || event.uChannel == 0)
+            continue;
+        
+        juce::uint8& uCount = m_noteCounts[event.uChannel - 1][event.uNote];
+        if(uCount++ == 0)
+        {
+            const juce::uint8 noteOn[] = { (juce::uint8) (0x90 | (event.uChannel - 1)), event.uNote, event.uVelocity };
+            outputMidi.addEvent(noteOn, sizeof(noteOn), iSamplePosition);
+            m_iChannelNotes[event.uChannel - 1]++;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    MidiNoteScheduler.h
+    Created: 17 Oct 2026 8:14:36pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+
+// Queue of generated notes at absolute sample times, rendered block by block. Events
+// due in a later block stay queued, so they come out sample-accurately across block
+// boundaries. Keeps a count of the voices holding each output note, so a note shared
+// by overlapping or consecutive chords is only started and ended once.
+// Only Prepare() allocates, everything else is safe on the audio thread.
+class MidiNoteScheduler
+{
+public:
+    MidiNoteScheduler();
+    ~MidiNoteScheduler();
+    
+    // Makes room for iCapacity pending events and forgets everything
+    void Prepare(int iCapacity);
+    // Forgets pending events and which notes are sounding
+    void Reset();
+    
+    // iSource identifies the voice (chord) a note belongs to. A note-off and a note-on for the
+    // same note at the same sample from different voices cancel out, the note keeps sounding.
+    // From the same voice they re-articulate the note. Returns false if the queue is full, which
+    // refuses note-ons before note-offs so held notes can always be ended.
+    bool ScheduleNoteOn(juce::int64 iSampleTime, int iChannel, int iNote, juce::uint8 uVelocity, int iSource);
+    bool ScheduleNoteOff(juce::int64 iSampleTime, int iChannel, int iNote, int iSource);
+    
+    // Emits everything due before iBlockStart + iNumSamples, at block relative sample positions
+    void RenderBlock(juce::int64 iBlockStart, int iNumSamples, juce::MidiBuffer& outputMidi);
+    
+    int GetNumPending() const { return m_iNumEvents; }
+    bool IsNoteSounding(int iChannel, int iNote) const;
+    // True while the channel has notes sounding or events queued, its last note-off hasn't gone out yet
+    bool IsChannelActive(int iChannel) const;
+    // Sample time of the note-off that last left the channel silent, 0 if none has
+    juce::int64 GetChannelReleaseTime(int iChannel) const { return m_iChannelReleaseTime[iChannel - 1]; }
+    
+private:
+    struct Event
+    {
+        juce::int64 iSampleTime;
+        juce::uint32 uOrder;        // Schedule order, keeps events at the same sample in order
+        juce::int16 iSource;
+        juce::uint8 uChannel;       // 1-16, 0 once a note-off/note-on pair has cancelled out
+        juce::uint8 uNote;
+        juce::uint8 uVelocity;      // 0 for note-offs
+    };
+    
+    bool Schedule(juce::int64 iSampleTime, int iChannel, int iNote, juce::uint8 uVelocity, int iSource);
+    void RenderSampleEvents(int iNumSampleEvents, int iSamplePosition, juce::MidiBuffer& outputMidi);
+    
+    // Heap comparator, puts the earliest event at the front
+    static bool IsLater(const Event& a, const Event& b);
+    
+    juce::HeapBlock<Event> m_events;            // Binary heap ordered by IsLater
+    juce::HeapBlock<Event> m_sampleEvents;      // Events of the sample being rendered
+    int m_iCapacity;
+    int m_iNumEvents;
+    juce::uint32 m_uNextOrder;
+    
+    // Voices currently holding each output note
+    juce::uint8 m_noteCounts[MIDI_CHANNELS][SCALES_TOTAL_STEPS];
+    // Per channel, events queued and notes sounding (see IsChannelActive())
+    int m_iChannelEvents[MIDI_CHANNELS];
+    int m_iChannelNotes[MIDI_CHANNELS];
+    juce::int64 m_iChannelReleaseTime[MIDI_CHANNELS];
+    // Index in m_sampleEvents of a note-off that a note-on at the same sample can take over, -1 if none
+    int m_iPendingNoteOff[MIDI_CHANNELS][SCALES_TOTAL_STEPS];
+    
+    JUCE_DECLARE_NON_COPYABLE (MidiNoteScheduler)
+};
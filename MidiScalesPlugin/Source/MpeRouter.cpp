@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    MpeRouter.cpp
+    Created: 17 Oct 2026 11:53:19pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "MpeRouter.h"
+
+MpeRouter::MpeRouter()
+{
+    Reset();
+}
+
+MpeRouter::~MpeRouter()
+{
+}
+
+void MpeRouter::Reset()
+{
+    for(int i = 0; i < MIDI_CHANNELS; i++)
+    {
+        m_expression[i].iPitchBend = 8192;
+        m_expression[i].uPressure = 0;
+        m_expression[i].uTimbre = 64;
+        
+        m_iChannelTones[i] = 0;
+    }
+}
+
+void MpeRouter::AllocateChannels(int iNumTones, const MidiNoteScheduler& noteScheduler, juce::uint8* pToneChannels)
+{
+    for(int iTone = 0; iTone < iNumTones; iTone++)
+    {
+        int iBestChannel = MPE_FIRST_MEMBER_CHANNEL;
+        
+        for(int iChannel = MPE_FIRST_MEMBER_CHANNEL + 1; iChannel <= MPE_LAST_MEMBER_CHANNEL; iChannel++)
+        {
+            const int iTones = m_iChannelTones[iChannel - 1];
+            const int iBestTones = m_iChannelTones[iBestChannel - 1];
+            if(iTones != iBestTones)
+            {
+                if(iTones < iBestTones)
+                    iBestChannel = iChannel;
+                continue;
+            }
+            
+            // A released chord's notes can still be queued or sounding on it
+            const bool bActive = noteScheduler.IsChannelActive(iChannel);
+            const bool bBestActive = noteScheduler.IsChannelActive(iBestChannel);
+            if(bActive != bBestActive)
+            {
+                if(!bActive)
+                    iBestChannel = iChannel;
+                continue;
+            }
+            
+            if(noteScheduler.GetChannelReleaseTime(iChannel) < noteScheduler.GetChannelReleaseTime(iBestChannel))
+                iBestChannel = iChannel;
+        }
+        
+        m_iChannelTones[iBestChannel - 1]++;
+        pToneChannels[iTone] = (juce::uint8) iBestChannel;
+    }
+}
+
+void MpeRouter::ReleaseChannels(const juce::uint8* pToneChannels, int iNumTones)
+{
+    for(int iTone = 0; iTone < iNumTones; iTone++)
+    {
+        const int iIndex = pToneChannels[iTone] - 1;
+        jassert(m_iChannelTones[iIndex] > 0);
+        
+        m_iChannelTones[iIndex] = juce::jmax(0, m_iChannelTones[iIndex] - 1);
+    }
+}
+
+bool MpeRouter::UpdateExpression(const juce::uint8* pMessage, int iNumBytes)
+{
+    const int iStatus = pMessage[0] & 0xf0;
+    Expression& expression = m_expression[pMessage[0] & 0x0f];
+    
+    if(iStatus == 0xe0 && iNumBytes >= 3)
+        expression.iPitchBend = pMessage[1] | (pMessage[2] << 7);
+    else if(iStatus == 0xd0 && iNumBytes >= 2)
+        expression.uPressure = pMessage[1];
+    else if(iStatus == 0xb0 && iNumBytes >= 3 && pMessage[1] == MPE_TIMBRE_CONTROLLER)
+        expression.uTimbre = pMessage[2];
+    else
+        return false;
+    
+    return true;
+}
+
+void MpeRouter::SendExpression(int iInputChannel, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi) const
+{
+    const Expression& expression = m_expression[(iInputChannel - 1) % MIDI_CHANNELS];
+    
+    // Channel nibbles are filled in per tone channel
+    const juce::uint8 pitchBend[] = { 0xe0, (juce::uint8) (expression.iPitchBend & 0x7f), (juce::uint8) ((expression.iPitchBend >> 7) & 0x7f) };
+    const juce::uint8 pressure[] = { 0xd0, expression.uPressure };
+    const juce::uint8 timbre[] = { 0xb0, MPE_TIMBRE_CONTROLLER, expression.uTimbre };
+    
+    AddToToneChannels(pitchBend, sizeof(pitchBend), pToneChannels, iNumTones, iSamplePosition, outputMidi);
+    AddToToneChannels(pressure, sizeof(pressure), pToneChannels, iNumTones, iSamplePosition, outputMidi);
+    AddToToneChannels(timbre, sizeof(timbre), pToneChannels, iNumTones, iSamplePosition, outputMidi);
+}
+
+void MpeRouter::ForwardExpression(const juce::uint8* pMessage, int iNumBytes, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi)
+{
+    AddToToneChannels(pMessage, iNumBytes, pToneChannels, iNumTones, iSamplePosition, outputMidi);
+}
+
+void MpeRouter::AddToToneChannels(const juce::uint8* pMessage, int iNumBytes, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi)
+{
+    juce::uint8 channelMessage[3];
+    jassert(iNumBytes <= (int) sizeof(channelMessage));
+    
+    std::memcpy(channelMessage, pMessage, (size_t) juce::jmin(iNumBytes, (int) sizeof(channelMessage)));
+    
+    juce::uint32 uSentChannels = 0;
+    for(int iTone = 0; iTone < iNumTones; iTone++)
+    {
+        const int iChannel = pToneChannels[iTone];
+        if((uSentChannels >> iChannel) & 1)
+            continue;
+        
+        uSentChannels |= 1u << iChannel;
+        channelMessage[0] = (juce::uint8) ((pMessage[0] & 0xf0) | (iChannel - 1));
+        outputMidi.addEvent(channelMessage, juce::jmin(iNumBytes, (int) sizeof(channelMessage)), iSamplePosition);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    MpeRouter.h
+    Created: 17 Oct 2026 11:53:04pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+#include "MidiNoteScheduler.h"
+
+// MPE in and out. Every chord tone gets a member channel of its own from a fixed pool, so
+// a synth can bend and press each tone separately, and the expression of the finger (input
+// channel) that started a chord is copied to all of its tones' channels. Tones share
+// channels once the pool runs out. Nothing here allocates.
+class MpeRouter
+{
+public:
+    MpeRouter();
+    ~MpeRouter();
+    
+    // Frees every channel and forgets the expression of every input channel
+    void Reset();
+    
+    // Member channels for a chord's tones, the ones holding the fewest tones first, then the ones
+    // whose last note-off noteScheduler has already sent, released the longest ago so release tails
+    // keep their expression
+    void AllocateChannels(int iNumTones, const MidiNoteScheduler& noteScheduler, juce::uint8* pToneChannels);
+    // The chord's tones stop holding their channels. A channel still isn't free until its
+    // note-offs, possibly strummed or arpeggiated later, have gone out.
+    void ReleaseChannels(const juce::uint8* pToneChannels, int iNumTones);
+    
+    // Remembers pitch bend, channel pressure and timbre per input channel, returns false for any other message
+    bool UpdateExpression(const juce::uint8* pMessage, int iNumBytes);
+    
+    // The input channel's current expression on each tone channel, sent before the chord's notes
+    void SendExpression(int iInputChannel, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi) const;
+    // One expression message on each tone channel, channels shared by several tones get it once
+    static void ForwardExpression(const juce::uint8* pMessage, int iNumBytes, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi);
+    
+private:
+    // Adds the message with its channel replaced by each of the tone channels
+    static void AddToToneChannels(const juce::uint8* pMessage, int iNumBytes, const juce::uint8* pToneChannels, int iNumTones, int iSamplePosition, juce::MidiBuffer& outputMidi);
+    
+    struct Expression
+    {
+        int iPitchBend;             // 14 bit, 8192 is centred
+        juce::uint8 uPressure;
+        juce::uint8 uTimbre;
+    };
+    
+    // Per input channel (1-16 at index 0-15)
+    Expression m_expression[MIDI_CHANNELS];
+    
+    // Per output channel, tones of held chords on it
+    int m_iChannelTones[MIDI_CHANNELS];
+    
+    JUCE_DECLARE_NON_COPYABLE (MpeRouter)
+};
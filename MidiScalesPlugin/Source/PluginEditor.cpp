@@ -14,7 +14,7 @@
 MidiScalesPluginAudioProcessorEditor::MidiScalesPluginAudioProcessorEditor (MidiScalesPluginAudioProcessor& p)
     : AudioProcessorEditor (&p),
       m_audioProcessor (p),
-      m_keyboardComponent(p.m_keyboardState,  BaseKeyboardComponent::horizontalKeyboard)
+      m_keyboardComponent(m_keyboardState,  BaseKeyboardComponent::horizontalKeyboard)
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
@@ -47,34 +47,127 @@ MidiScalesPluginAudioProcessorEditor::MidiScalesPluginAudioProcessorEditor (Midi
     m_keyboardComponent.setKeyWidth(46);
     
     
+    const ScaleLibrary& scaleLibrary = ScaleLibrary::GetInstance();
+    
     addAndMakeVisible (m_ChordType);
-    for(int i = 1; i <= Chords::Type::Total; i++)
+    for(int i = 1; i < scaleLibrary.GetNumChords(); i++)
     {
-        Chords::Type::eType chordType = (Chords::Type::eType) i;
-        m_ChordType.addItem (Helpers::GetChordTypeString(chordType),  chordType);
+        if(scaleLibrary.IsValidChord(i))
+            m_ChordType.addItem (juce::String::fromUTF8(scaleLibrary.GetChordName(i)),  i);
     }
-    m_ChordType.setSelectedId(Chords::Type::MajorTriad);
     m_ChordType.onChange = [this] { ChordTypeComboChanged(); };
-    m_ChordType.onChange();
     
     addAndMakeVisible (m_ScaleType);
-    for(int i = 1; i <= Scales::Type::Total; i++)
+    for(int i = 1; i < scaleLibrary.GetNumScales(); i++)
     {
-        Scales::Type::eType scaleType = (Scales::Type::eType) i;
-        m_ScaleType.addItem (Helpers::GetScaleTypeString(scaleType),  scaleType);
+        if(scaleLibrary.IsValidScale(i))
+            m_ScaleType.addItem (juce::String::fromUTF8(scaleLibrary.GetScaleName(i)),  i);
     }
-    m_ScaleType.setSelectedId(Scales::Type::Major);
     m_ScaleType.onChange = [this] { ScaleTypeComboChanged(); };
-    m_ScaleType.onChange();
+    
+    // Spelled the way the processor's current scale is
+    const bool bSharps = m_audioProcessor.GetScaleModel()->UsesSharps();
     
     addAndMakeVisible (m_ScaleNote);
     for(int i = 1; i <= SCALES_OCTAVE_STEPS; i++)
     {
-        m_ScaleNote.addItem (juce::MidiMessage::getMidiNoteName (i-1, true, false, m_keyboardComponent.getOctaveForMiddleC()),  i);
+        m_ScaleNote.addItem (juce::MidiMessage::getMidiNoteName (i-1, bSharps, false, m_keyboardComponent.getOctaveForMiddleC()),  i);
     }
-    m_ScaleNote.setSelectedId(1);
     m_ScaleNote.onChange = [this] { ScaleNoteComboChanged(); };
-    m_ScaleNote.onChange();
+    
+    addAndMakeVisible (m_QuantizeLabel);
+    m_QuantizeLabel.setText ("Quantize: ", juce::dontSendNotification);
+    m_QuantizeLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_QuantizeLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_QuantizeMode);
+    m_QuantizeMode.addItem ("Off (out of scale notes are muted)", Quantize::Mode::Off + 1);
+    m_QuantizeMode.addItem ("Nearest scale note", Quantize::Mode::Nearest + 1);
+    m_QuantizeMode.addItem ("Next scale note up", Quantize::Mode::Up + 1);
+    m_QuantizeMode.addItem ("Next scale note down", Quantize::Mode::Down + 1);
+    m_QuantizeMode.addItem ("Scale degrees on white keys", Quantize::Mode::Degree + 1);
+    m_QuantizeMode.onChange = [this] { QuantizeModeComboChanged(); };
+    
+    addAndMakeVisible (m_VoicingLabel);
+    m_VoicingLabel.setText ("Voicing: ", juce::dontSendNotification);
+    m_VoicingLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_VoicingLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_VoicingMode);
+    m_VoicingMode.addItem ("Root position", Voicing::Mode::RootPosition + 1);
+    m_VoicingMode.addItem ("Voice leading", Voicing::Mode::VoiceLeading + 1);
+    m_VoicingMode.onChange = [this] { VoicingModeComboChanged(); };
+    
+    addAndMakeVisible (m_VoicingRegisterLabel);
+    m_VoicingRegisterLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_VoicingRegisterLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_VoicingRegister);
+    m_VoicingRegister.setRange (0.0, SCALES_TOTAL_STEPS - 1, 1.0);
+    m_VoicingRegister.setColour (juce::Slider::thumbColourId, juce::Colours::black);
+    m_VoicingRegister.onValueChange = [this] { VoicingRegisterChanged(); };
+    
+    addAndMakeVisible (m_StrumLabel);
+    m_StrumLabel.setText ("Strum: ", juce::dontSendNotification);
+    m_StrumLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_StrumLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_StrumMs);
+    m_StrumMs.setRange (0.0, STRUM_MAX_NOTE_MS, 1.0);
+    m_StrumMs.setTextValueSuffix (" ms");
+    m_StrumMs.setTextBoxStyle (juce::Slider::TextBoxRight, false, 60, 20);
+    m_StrumMs.onValueChange = [this] { StrumChanged(); };
+    
+    addAndMakeVisible (m_StrumDirection);
+    for(int i = 0; i < Strum::Direction::Total; i++)
+        m_StrumDirection.addItem (Helpers::GetStrumDirectionString((Strum::Direction::eDirection) i), i + 1);
+    m_StrumDirection.onChange = [this] { StrumChanged(); };
+    
+    addAndMakeVisible (m_StrumVelocityLabel);
+    m_StrumVelocityLabel.setText ("Velocity: ", juce::dontSendNotification);
+    m_StrumVelocityLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_StrumVelocityLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_StrumVelocityCurve);
+    m_StrumVelocityCurve.setRange (-100.0, 100.0, 1.0);
+    m_StrumVelocityCurve.setTextValueSuffix (" %");
+    m_StrumVelocityCurve.setTextBoxStyle (juce::Slider::TextBoxRight, false, 55, 20);
+    m_StrumVelocityCurve.onValueChange = [this] { StrumChanged(); };
+    
+    addAndMakeVisible (m_HumanizeLabel);
+    m_HumanizeLabel.setText ("Humanize: ", juce::dontSendNotification);
+    m_HumanizeLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_HumanizeLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_Humanize);
+    m_Humanize.setRange (0.0, 100.0, 1.0);
+    m_Humanize.setTextValueSuffix (" %");
+    m_Humanize.setTextBoxStyle (juce::Slider::TextBoxRight, false, 55, 20);
+    m_Humanize.onValueChange = [this] { StrumChanged(); };
+    
+    addAndMakeVisible (m_ArpPattern);
+    for(int i = 0; i < Arpeggio::Pattern::Total; i++)
+        m_ArpPattern.addItem (Helpers::GetArpPatternString((Arpeggio::Pattern::ePattern) i), i + 1);
+    m_ArpPattern.onChange = [this] { ArpeggiatorChanged(); };
+    
+    addAndMakeVisible (m_ArpRate);
+    for(int i = 0; i < Arpeggio::Rate::Total; i++)
+        m_ArpRate.addItem (Helpers::GetArpRateString((Arpeggio::Rate::eRate) i), i + 1);
+    m_ArpRate.onChange = [this] { ArpeggiatorChanged(); };
+    
+    addAndMakeVisible (m_ArpGateLabel);
+    m_ArpGateLabel.setText ("Gate: ", juce::dontSendNotification);
+    m_ArpGateLabel.setFont (juce::Font (16.0f, juce::Font::plain));
+    m_ArpGateLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    
+    addAndMakeVisible (m_ArpGate);
+    m_ArpGate.setRange (1.0, 100.0, 1.0);
+    m_ArpGate.setTextValueSuffix (" %");
+    m_ArpGate.setTextBoxStyle (juce::Slider::TextBoxRight, false, 55, 20);
+    m_ArpGate.onValueChange = [this] { ArpeggiatorChanged(); };
+    
+    // The processor owns the state (possibly restored from the session), just mirror it
+    UpdateControlsFromProcessor();
     
     m_ToggleLookAndFeel.setColour(juce::ToggleButton::textColourId, juce::Colours::black);
     m_ToggleLookAndFeel.setColour(juce::ToggleButton::tickColourId, juce::Colours::black);
@@ -82,13 +175,45 @@ MidiScalesPluginAudioProcessorEditor::MidiScalesPluginAudioProcessorEditor (Midi
     
     addAndMakeVisible(m_ToggleSharps);
     
-    m_ToggleSharps.setToggleState(true, juce::dontSendNotification);
+    m_ToggleSharps.setToggleState(bSharps, juce::dontSendNotification);
     m_ToggleSharps.setLookAndFeel(&m_ToggleLookAndFeel);
     m_ToggleSharps.onClick = [this] { SharpsToggleClicked(); };
+    
+    addAndMakeVisible(m_ToggleDiatonic);
+    
+    m_ToggleDiatonic.setToggleState(m_audioProcessor.m_bDiatonicChords.get(), juce::dontSendNotification);
+    m_ToggleDiatonic.setLookAndFeel(&m_ToggleLookAndFeel);
+    m_ToggleDiatonic.onClick = [this] { DiatonicToggleClicked(); };
+    
+    addAndMakeVisible(m_ToggleArpeggiator);
+    
+    m_ToggleArpeggiator.setToggleState(m_audioProcessor.m_bArpeggiator.get(), juce::dontSendNotification);
+    m_ToggleArpeggiator.setLookAndFeel(&m_ToggleLookAndFeel);
+    m_ToggleArpeggiator.onClick = [this] { ArpeggiatorChanged(); };
+    
+    addAndMakeVisible(m_ToggleMpe);
+    
+    m_ToggleMpe.setToggleState(m_audioProcessor.m_bMpe.get(), juce::dontSendNotification);
+    m_ToggleMpe.setTooltip("Every chord note on its own channel, with the expression of the key that played it");
+    m_ToggleMpe.setLookAndFeel(&m_ToggleLookAndFeel);
+    m_ToggleMpe.onClick = [this] { MpeToggleClicked(); };
+    
+    addAndMakeVisible (m_ProcessingStatsLabel);
+    m_ProcessingStatsLabel.setFont (juce::Font (13.0f, juce::Font::plain));
+    m_ProcessingStatsLabel.setColour (juce::Label::textColourId, juce::Colours::black);
+    m_ProcessingStatsLabel.setJustificationType (juce::Justification::topLeft);
+    
+    m_iTimerTicks = 0;
+    m_audioProcessor.m_keyboardStateFifo.Attach();
+    m_audioProcessor.m_processingStats.Attach();
+    startTimerHz(KEYBOARD_UI_REFRESH_HZ);
 }
 
 MidiScalesPluginAudioProcessorEditor::~MidiScalesPluginAudioProcessorEditor()
 {
+    stopTimer();
+    m_audioProcessor.m_keyboardStateFifo.Detach();
+    m_audioProcessor.m_processingStats.Detach();
 }
 
 //==============================================================================
@@ -142,6 +267,48 @@ void MidiScalesPluginAudioProcessorEditor::resized()
     int iCurrentVerticleSpacing = iKeyboardTopSpacing + iLabelTopSpacing + iLabelHeight;
     
     m_ToggleSharps.setBounds(iCurrentLeftSpacing, iCurrentVerticleSpacing, 200, iCheckboxHeight);
+    m_QuantizeLabel.setBounds(iCurrentLeftSpacing + 200, iCurrentVerticleSpacing, iScaleChordLabelWidth, iCheckboxHeight);
+    m_QuantizeMode.setBounds(iCurrentLeftSpacing + 200 + iScaleChordLabelWidth, iCurrentVerticleSpacing, 260, iCheckboxHeight);
+    const int iDiatonicLeftSpacing = 200 + iScaleChordLabelWidth + 260 + 20;
+    m_ToggleDiatonic.setBounds(iCurrentLeftSpacing + iDiatonicLeftSpacing, iCurrentVerticleSpacing, iEffectiveWidth - iDiatonicLeftSpacing, iCheckboxHeight);
+    
+    iCurrentVerticleSpacing += iCheckboxHeight + iKeyboardTopSpacing;
+    m_VoicingLabel.setBounds(iCurrentLeftSpacing, iCurrentVerticleSpacing, iScaleChordLabelWidth, iCheckboxHeight);
+    m_VoicingMode.setBounds(iCurrentLeftSpacing + iScaleChordLabelWidth, iCurrentVerticleSpacing, iScaleTypeWidth, iCheckboxHeight);
+    m_VoicingRegisterLabel.setBounds(iCurrentLeftSpacing + iScaleChordLabelWidth + iScaleTypeWidth + 20, iCurrentVerticleSpacing, 170, iCheckboxHeight);
+    m_VoicingRegister.setBounds(iCurrentLeftSpacing + iScaleChordLabelWidth + iScaleTypeWidth + 20 + 170, iCurrentVerticleSpacing,
+                                iEffectiveWidth - (iScaleChordLabelWidth + iScaleTypeWidth + 20 + 170), iCheckboxHeight);
+    
+    iCurrentVerticleSpacing += iCheckboxHeight + iKeyboardTopSpacing;
+    int iStrumLeftSpacing = iCurrentLeftSpacing;
+    m_StrumLabel.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 60, iCheckboxHeight);
+    iStrumLeftSpacing += 60;
+    m_StrumMs.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 150, iCheckboxHeight);
+    iStrumLeftSpacing += 150;
+    m_StrumDirection.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 100, iCheckboxHeight);
+    iStrumLeftSpacing += 100 + 10;
+    m_StrumVelocityLabel.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 65, iCheckboxHeight);
+    iStrumLeftSpacing += 65;
+    m_StrumVelocityCurve.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 120, iCheckboxHeight);
+    iStrumLeftSpacing += 120 + 10;
+    m_HumanizeLabel.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, 75, iCheckboxHeight);
+    iStrumLeftSpacing += 75;
+    m_Humanize.setBounds(iStrumLeftSpacing, iCurrentVerticleSpacing, iEffectiveWidth - (iStrumLeftSpacing - iCurrentLeftSpacing), iCheckboxHeight);
+    
+    iCurrentVerticleSpacing += iCheckboxHeight + iKeyboardTopSpacing;
+    int iArpLeftSpacing = iCurrentLeftSpacing;
+    m_ToggleArpeggiator.setBounds(iArpLeftSpacing, iCurrentVerticleSpacing, 120, iCheckboxHeight);
+    iArpLeftSpacing += 120;
+    m_ArpPattern.setBounds(iArpLeftSpacing, iCurrentVerticleSpacing, 120, iCheckboxHeight);
+    iArpLeftSpacing += 120 + 10;
+    m_ArpRate.setBounds(iArpLeftSpacing, iCurrentVerticleSpacing, 80, iCheckboxHeight);
+    iArpLeftSpacing += 80 + 10;
+    m_ArpGateLabel.setBounds(iArpLeftSpacing, iCurrentVerticleSpacing, 50, iCheckboxHeight);
+    iArpLeftSpacing += 50;
+    m_ArpGate.setBounds(iArpLeftSpacing, iCurrentVerticleSpacing, iEffectiveWidth - (iArpLeftSpacing - iCurrentLeftSpacing), iCheckboxHeight);
+    
+    iCurrentVerticleSpacing += iCheckboxHeight + iKeyboardTopSpacing;
+    m_ToggleMpe.setBounds(iCurrentLeftSpacing, iCurrentVerticleSpacing, iEffectiveWidth, iCheckboxHeight);
     
     /*m_selectedChord.setBounds (iLabelLeftRightSpacing, iLabelTopSpacing,
                                iEffectiveWidth,  iLabelHeight);*/
@@ -149,6 +316,10 @@ void MidiScalesPluginAudioProcessorEditor::resized()
     iCurrentVerticleSpacing += iCheckboxHeight + iKeyboardTopSpacing;
     m_keyboardComponent.setBounds (iCurrentLeftSpacing, iCurrentVerticleSpacing,
                                   iEffectiveWidth, iKeyboardHeight);
+    
+    iCurrentVerticleSpacing += iKeyboardHeight + iKeyboardTopSpacing;
+    m_ProcessingStatsLabel.setBounds (iCurrentLeftSpacing, iCurrentVerticleSpacing,
+                                      iEffectiveWidth, iLabelHeight);
 }
 
 void MidiScalesPluginAudioProcessorEditor::ScaleNoteComboChanged()
@@ -157,7 +328,7 @@ void MidiScalesPluginAudioProcessorEditor::ScaleNoteComboChanged()
     int scaleNote = iSelectedId > 0 ? iSelectedId - 1 : -1;
     Scales::Type::eType selectedType = (Scales::Type::eType) m_ScaleType.getSelectedId();
     
-    m_audioProcessor.SetScaleSafe(scaleNote, selectedType);
+    m_audioProcessor.SetScaleSafe(scaleNote, selectedType, m_ToggleSharps.getToggleState());
     
     SetKeyboardScale();
 }
@@ -168,7 +339,7 @@ void MidiScalesPluginAudioProcessorEditor::ScaleTypeComboChanged()
     int scaleNote = iSelectedId > 0 ? iSelectedId - 1 : -1;
     Scales::Type::eType selectedType = (Scales::Type::eType) m_ScaleType.getSelectedId();
     
-    m_audioProcessor.SetScaleSafe(scaleNote, selectedType);
+    m_audioProcessor.SetScaleSafe(scaleNote, selectedType, m_ToggleSharps.getToggleState());
     
     SetKeyboardScale();
 }
@@ -179,23 +350,171 @@ void MidiScalesPluginAudioProcessorEditor::ChordTypeComboChanged()
     m_audioProcessor.m_ChordType.set(selectedType);
 }
 
-void MidiScalesPluginAudioProcessorEditor::SetKeyboardScale()
+void MidiScalesPluginAudioProcessorEditor::QuantizeModeComboChanged()
 {
-    int iSelectedId = m_ScaleNote.getSelectedId();
-    int scaleNote = iSelectedId > 0 ? iSelectedId - 1 : -1;
-    juce::String selectedText = m_ScaleNote.getItemText(m_ScaleNote.getSelectedItemIndex());
-    selectedText = selectedText.replace("#", "").replace("b", "");
-    int iBaseNote = Helpers::GetNoteType(selectedText.toRawUTF8());
+    const int iSelectedId = m_QuantizeMode.getSelectedId();
+    if(iSelectedId > 0)
+        m_audioProcessor.m_QuantizeMode.set((Quantize::Mode::eMode) (iSelectedId - 1));
+}
+
+void MidiScalesPluginAudioProcessorEditor::VoicingModeComboChanged()
+{
+    const int iSelectedId = m_VoicingMode.getSelectedId();
+    if(iSelectedId > 0)
+        m_audioProcessor.m_VoicingMode.set((Voicing::Mode::eMode) (iSelectedId - 1));
     
-    m_keyboardComponent.SetScale(scaleNote, iBaseNote, (Scales::Type::eType) m_ScaleType.getSelectedId());
+    m_VoicingRegister.setEnabled(m_audioProcessor.m_VoicingMode.get() == Voicing::Mode::VoiceLeading);
 }
 
-void MidiScalesPluginAudioProcessorEditor::SharpsToggleClicked()
+void MidiScalesPluginAudioProcessorEditor::VoicingRegisterChanged()
+{
+    int iLowNote = (int) m_VoicingRegister.getMinValue();
+    int iHighNote = (int) m_VoicingRegister.getMaxValue();
+    
+    // Narrower than an octave and some chords would have no inversion that fits
+    if(iHighNote - iLowNote < VOICING_MIN_REGISTER_STEPS)
+    {
+        if(m_VoicingRegister.getThumbBeingDragged() == 1)
+            iLowNote = juce::jmax(0, iHighNote - VOICING_MIN_REGISTER_STEPS);
+        iHighNote = iLowNote + VOICING_MIN_REGISTER_STEPS;
+        
+        m_VoicingRegister.setMinAndMaxValues(iLowNote, iHighNote, juce::dontSendNotification);
+    }
+    
+    m_audioProcessor.m_iVoicingLowNote.set(iLowNote);
+    m_audioProcessor.m_iVoicingHighNote.set(iHighNote);
+    
+    m_VoicingRegisterLabel.setText ("Register: " + juce::MidiMessage::getMidiNoteName (iLowNote, true, true, m_keyboardComponent.getOctaveForMiddleC())
+                                    + " - " + juce::MidiMessage::getMidiNoteName (iHighNote, true, true, m_keyboardComponent.getOctaveForMiddleC()),
+                                    juce::dontSendNotification);
+}
+
+void MidiScalesPluginAudioProcessorEditor::StrumChanged()
+{
+    m_audioProcessor.m_iStrumMs.set((int) m_StrumMs.getValue());
+    if(m_StrumDirection.getSelectedId() > 0)
+        m_audioProcessor.m_StrumDirection.set((Strum::Direction::eDirection) (m_StrumDirection.getSelectedId() - 1));
+    m_audioProcessor.m_iStrumVelocityCurve.set((int) m_StrumVelocityCurve.getValue());
+    m_audioProcessor.m_iHumanize.set((int) m_Humanize.getValue());
+}
+
+void MidiScalesPluginAudioProcessorEditor::ArpeggiatorChanged()
+{
+    m_audioProcessor.m_bArpeggiator.set(m_ToggleArpeggiator.getToggleState());
+    if(m_ArpPattern.getSelectedId() > 0)
+        m_audioProcessor.m_ArpPattern.set((Arpeggio::Pattern::ePattern) (m_ArpPattern.getSelectedId() - 1));
+    if(m_ArpRate.getSelectedId() > 0)
+        m_audioProcessor.m_ArpRate.set((Arpeggio::Rate::eRate) (m_ArpRate.getSelectedId() - 1));
+    m_audioProcessor.m_iArpGate.set((int) m_ArpGate.getValue());
+}
+
+void MidiScalesPluginAudioProcessorEditor::SetKeyboardScale()
+{
+    m_keyboardComponent.SetScale(m_audioProcessor.GetScaleModel());
+}
+
+void MidiScalesPluginAudioProcessorEditor::SetScaleNoteNames(bool bSharps)
 {
     int iPreviousSelectedId = m_ScaleNote.getSelectedItemIndex();
     for(int i = 1; i <= SCALES_OCTAVE_STEPS; i++)
     {
-        m_ScaleNote.changeItemText (i, juce::MidiMessage::getMidiNoteName (i-1, m_ToggleSharps.getToggleState(), false,         m_keyboardComponent.getOctaveForMiddleC()));
+        m_ScaleNote.changeItemText (i, juce::MidiMessage::getMidiNoteName (i-1, bSharps, false,         m_keyboardComponent.getOctaveForMiddleC()));
+    }
+    m_ScaleNote.setSelectedItemIndex(iPreviousSelectedId, juce::dontSendNotification);
+}
+
+void MidiScalesPluginAudioProcessorEditor::SharpsToggleClicked()
+{
+    SetScaleNoteNames(m_ToggleSharps.getToggleState());
+    
+    // Respells the scale, the selection itself hasn't changed
+    ScaleNoteComboChanged();
+}
+
+void MidiScalesPluginAudioProcessorEditor::DiatonicToggleClicked()
+{
+    m_audioProcessor.m_bDiatonicChords.set(m_ToggleDiatonic.getToggleState());
+}
+
+void MidiScalesPluginAudioProcessorEditor::MpeToggleClicked()
+{
+    m_audioProcessor.m_bMpe.set(m_ToggleMpe.getToggleState());
+}
+
+void MidiScalesPluginAudioProcessorEditor::UpdateControlsFromProcessor()
+{
+    const int iScaleNoteId = m_audioProcessor.GetScaleNote() + 1;
+    const int iScaleTypeId = m_audioProcessor.GetScaleType();
+    const int iChordTypeId = m_audioProcessor.m_ChordType.get();
+    const int iQuantizeModeId = m_audioProcessor.m_QuantizeMode.get() + 1;
+    
+    if(m_ChordType.getSelectedId() != iChordTypeId)
+        m_ChordType.setSelectedId(iChordTypeId, juce::dontSendNotification);
+    
+    if(m_QuantizeMode.getSelectedId() != iQuantizeModeId)
+        m_QuantizeMode.setSelectedId(iQuantizeModeId, juce::dontSendNotification);
+    
+    if(m_ToggleDiatonic.getToggleState() != m_audioProcessor.m_bDiatonicChords.get())
+        m_ToggleDiatonic.setToggleState(m_audioProcessor.m_bDiatonicChords.get(), juce::dontSendNotification);
+    
+    const int iVoicingModeId = m_audioProcessor.m_VoicingMode.get() + 1;
+    if(m_VoicingMode.getSelectedId() != iVoicingModeId)
+    {
+        m_VoicingMode.setSelectedId(iVoicingModeId, juce::dontSendNotification);
+        m_VoicingRegister.setEnabled(iVoicingModeId - 1 == Voicing::Mode::VoiceLeading);
     }
-    m_ScaleNote.setSelectedItemIndex(iPreviousSelectedId);
+    
+    const int iVoicingLowNote = m_audioProcessor.m_iVoicingLowNote.get();
+    const int iVoicingHighNote = m_audioProcessor.m_iVoicingHighNote.get();
+    if((int) m_VoicingRegister.getMinValue() != iVoicingLowNote || (int) m_VoicingRegister.getMaxValue() != iVoicingHighNote)
+    {
+        m_VoicingRegister.setMinAndMaxValues(iVoicingLowNote, iVoicingHighNote, juce::dontSendNotification);
+        VoicingRegisterChanged();
+    }
+    
+    m_StrumMs.setValue(m_audioProcessor.m_iStrumMs.get(), juce::dontSendNotification);
+    m_StrumDirection.setSelectedId(m_audioProcessor.m_StrumDirection.get() + 1, juce::dontSendNotification);
+    m_StrumVelocityCurve.setValue(m_audioProcessor.m_iStrumVelocityCurve.get(), juce::dontSendNotification);
+    m_Humanize.setValue(m_audioProcessor.m_iHumanize.get(), juce::dontSendNotification);
+    
+    if(m_ToggleArpeggiator.getToggleState() != m_audioProcessor.m_bArpeggiator.get())
+        m_ToggleArpeggiator.setToggleState(m_audioProcessor.m_bArpeggiator.get(), juce::dontSendNotification);
+    m_ArpPattern.setSelectedId(m_audioProcessor.m_ArpPattern.get() + 1, juce::dontSendNotification);
+    m_ArpRate.setSelectedId(m_audioProcessor.m_ArpRate.get() + 1, juce::dontSendNotification);
+    m_ArpGate.setValue(m_audioProcessor.m_iArpGate.get(), juce::dontSendNotification);
+    
+    if(m_ToggleMpe.getToggleState() != m_audioProcessor.m_bMpe.get())
+        m_ToggleMpe.setToggleState(m_audioProcessor.m_bMpe.get(), juce::dontSendNotification);
+    
+    const bool bSharps = m_audioProcessor.GetScaleModel()->UsesSharps();
+    if(m_ToggleSharps.getToggleState() != bSharps)
+    {
+        m_ToggleSharps.setToggleState(bSharps, juce::dontSendNotification);
+        SetScaleNoteNames(bSharps);
+    }
+    
+    if(m_ScaleNote.getSelectedId() != iScaleNoteId || m_ScaleType.getSelectedId() != iScaleTypeId)
+    {
+        m_ScaleNote.setSelectedId(iScaleNoteId, juce::dontSendNotification);
+        m_ScaleType.setSelectedId(iScaleTypeId, juce::dontSendNotification);
+    }
+    
+    if(m_keyboardComponent.GetScale() != m_audioProcessor.GetScaleModel())
+        SetKeyboardScale();
+}
+
+void MidiScalesPluginAudioProcessorEditor::timerCallback()
+{
+    m_audioProcessor.m_keyboardStateFifo.Drain(m_keyboardState);
+    
+    // Everything else is refreshed about 4 times a second
+    if(m_iTimerTicks++ % (KEYBOARD_UI_REFRESH_HZ / 4) != 0)
+        return;
+    
+    // Picks up state the host restored while the editor is open
+    UpdateControlsFromProcessor();
+    m_audioProcessor.ReleaseRetiredScaleModels();
+    
+    const ProcessingStats::Summary summary = m_audioProcessor.m_processingStats.Update();
+    m_ProcessingStatsLabel.setText (summary.ToString(), juce::dontSendNotification);
 }
@@ -16,7 +16,8 @@
 //==============================================================================
 /**
 */
-class MidiScalesPluginAudioProcessorEditor  : public juce::AudioProcessorEditor
+class MidiScalesPluginAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                              private juce::Timer
 {
 public:
     MidiScalesPluginAudioProcessorEditor (MidiScalesPluginAudioProcessor&);
@@ -29,16 +30,31 @@ public:
     void ScaleNoteComboChanged();
     void ScaleTypeComboChanged();
     void ChordTypeComboChanged();
+    void QuantizeModeComboChanged();
+    void VoicingModeComboChanged();
+    void VoicingRegisterChanged();
+    void StrumChanged();
+    void ArpeggiatorChanged();
     
     void SetKeyboardScale();
+    void SetScaleNoteNames(bool bSharps);
+    void UpdateControlsFromProcessor();
     
     void SharpsToggleClicked();
+    void DiatonicToggleClicked();
+    void MpeToggleClicked();
 
 private:
+    // Applies the audio thread's keyboard changes, and every few ticks collects the
+    // processing stats and shows their summary
+    void timerCallback() override;
+    
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     MidiScalesPluginAudioProcessor& m_audioProcessor;
     
+    // Message thread only, fed from the processor's KeyboardStateFifo
+    juce::MidiKeyboardState m_keyboardState;
     ScalesKeyboardComponent m_keyboardComponent;
     juce::Label m_selectedChord;
     juce::Label m_ChordLabel;
@@ -46,8 +62,32 @@ private:
     juce::ComboBox m_ChordType;
     juce::ComboBox m_ScaleType;
     juce::ComboBox m_ScaleNote;
+    juce::Label m_QuantizeLabel;
+    juce::ComboBox m_QuantizeMode;
+    juce::Label m_VoicingLabel;
+    juce::ComboBox m_VoicingMode;
+    juce::Label m_VoicingRegisterLabel;
+    juce::Slider m_VoicingRegister {juce::Slider::TwoValueHorizontal, juce::Slider::NoTextBox};
+    juce::Label m_StrumLabel;
+    juce::Slider m_StrumMs {juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight};
+    juce::ComboBox m_StrumDirection;
+    juce::Label m_StrumVelocityLabel;
+    juce::Slider m_StrumVelocityCurve {juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight};
+    juce::Label m_HumanizeLabel;
+    juce::Slider m_Humanize {juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight};
+    juce::ComboBox m_ArpPattern;
+    juce::ComboBox m_ArpRate;
+    juce::Label m_ArpGateLabel;
+    juce::Slider m_ArpGate {juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight};
     juce::LookAndFeel_V4 m_ToggleLookAndFeel;
     juce::ToggleButton m_ToggleSharps {"Black Keys as Sharps"};
+    juce::ToggleButton m_ToggleDiatonic {"Diatonic Chords"};
+    juce::ToggleButton m_ToggleArpeggiator {"Arpeggiator"};
+    juce::ToggleButton m_ToggleMpe {"MPE"};
+    juce::Label m_ProcessingStatsLabel;
+    // Shows the tooltips of the editor's controls
+    juce::TooltipWindow m_TooltipWindow {this};
+    int m_iTimerTicks;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiScalesPluginAudioProcessorEditor)
 };
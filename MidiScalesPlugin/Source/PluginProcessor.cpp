@@ -24,12 +24,34 @@ MidiScalesPluginAudioProcessor::MidiScalesPluginAudioProcessor()
                        )
 #endif
 {
-    m_keyboardState.reset();
-    m_ScaleNotes.ensureStorageAllocated(SCALES_OCTAVE_STEPS);
+    m_uScratchMidiBytes = 0;
+    m_iBlockStartSample = 0;
+    m_uNumProcessedBlocks.set(0);
+    m_iUnresolvedScaleType = 0;
+    m_iUnresolvedChordType = 0;
+    m_unresolvedScaleFallback = Scales::Type::Invalid;
+    m_unresolvedChordFallback = Chords::Type::Invalid;
     
-    m_iScaleNote = -1;
-    m_ScaleType = Scales::Type::Invalid;
-    m_ChordType.set(Chords::Type::Invalid);
+    // Maps the scale library on first use, never leave that to the audio thread
+    ScaleLibrary::GetInstance();
+    
+    // Defaults for a fresh instance, the editor and setStateInformation start from these
+    SetScaleSafe(Notes::Type::C, Scales::Type::Major, true);
+    m_ChordType.set(Chords::Type::MajorTriad);
+    m_QuantizeMode.set(Quantize::Mode::Off);
+    m_bDiatonicChords.set(false);
+    m_VoicingMode.set(Voicing::Mode::RootPosition);
+    m_iVoicingLowNote.set(VOICING_DEFAULT_LOW_NOTE);
+    m_iVoicingHighNote.set(VOICING_DEFAULT_HIGH_NOTE);
+    m_iStrumMs.set(0);
+    m_StrumDirection.set(Strum::Direction::Up);
+    m_iStrumVelocityCurve.set(0);
+    m_iHumanize.set(0);
+    m_bArpeggiator.set(false);
+    m_ArpPattern.set(Arpeggio::Pattern::Up);
+    m_ArpRate.set(Arpeggio::Rate::Sixteenth);
+    m_iArpGate.set(ARPEGGIATOR_DEFAULT_GATE);
+    m_bMpe.set(false);
 }
 
 MidiScalesPluginAudioProcessor::~MidiScalesPluginAudioProcessor()
@@ -101,14 +123,32 @@ void MidiScalesPluginAudioProcessor::changeProgramName (int index, const juce::S
 //==============================================================================
 void MidiScalesPluginAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
+    // Strummed notes of the input events in the last strum window can still be pending
+    const int iStrumWindowInputEvents = juce::jmin(ChordStrummer::GetMaxStrumSamples(sampleRate), STRUM_MAX_WINDOW_INPUT_EVENTS);
+    // Each arpeggiator step starts and ends a note, like an input event
+    const int iMaxInputEvents = juce::jmax(samplesPerBlock, MIDI_MIN_RESERVED_INPUT_EVENTS) + iStrumWindowInputEvents
+                              + Arpeggiator::GetMaxStepsPerBlock(sampleRate, samplesPerBlock);
+    m_uScratchMidiBytes = GetScratchMidiBytes(iMaxInputEvents);
+    
+    m_processedMidi.ensureSize(m_uScratchMidiBytes);
+    
+    m_noteScheduler.Prepare(GetMaxChordNoteEvents(iMaxInputEvents));
+    m_chordVoices.Reset();
+    m_chordVoicer.Reset();
+    m_chordStrummer.Prepare(sampleRate);
+    m_arpeggiator.Prepare(sampleRate);
+    m_mpeRouter.Reset();
+    m_sustainTracker.Reset();
+    m_iBlockStartSample = 0;
+    
+    m_processingStats.Prepare(sampleRate);
 }
 
 void MidiScalesPluginAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    ReleaseRetiredScaleModels();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -137,67 +177,285 @@ bool MidiScalesPluginAudioProcessor::isBusesLayoutSupported (const BusesLayout&
 
 void MidiScalesPluginAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    RealtimeAllocations::ScopedNoAllocationRegion noAllocationRegion;
+    
+    const juce::int64 iStartTicks = juce::Time::getHighResolutionTicks();
+    const int iNumInputEvents = midiMessages.getNumEvents();
+    int iNumChordNotes = 0;
+    
     buffer.clear();
 
-    juce::MidiBuffer processedMidi;
-    juce::MidiBuffer keyboardStateMidi;
-    int iSamplePosition;
-    juce::MidiMessage m;
+    m_processedMidi.clear();
+    
+    // ProcessMidi, RenderSteps and RenderBlock all write into one of these two. Growing
+    // m_processedMidi past what prepareToPlay reserved, or the host's buffer past what the
+    // host reserved (e.g. in the copy-back below), reallocates through realloc, which the
+    // operator new hook of the no-allocation region never sees.
+    RealtimeAllocations::ScopedStorageCheck<juce::Array<juce::uint8>> processedStorageCheck(m_processedMidi.data);
+    RealtimeAllocations::ScopedStorageCheck<juce::Array<juce::uint8>> hostStorageCheck(midiMessages.data);
     
     // Start - Atomic Variable Access
     
     Chords::Type::eType chordType = m_ChordType.get();
+    const ScaleModel& scaleModel = *m_pAudioScaleModel.get();
+    const Quantize::Mode::eMode quantizeMode = m_QuantizeMode.get();
+    const bool bDiatonicChords = m_bDiatonicChords.get();
+    m_chordVoicer.SetVoicing(m_VoicingMode.get(), m_iVoicingLowNote.get(), m_iVoicingHighNote.get());
+    m_chordStrummer.SetStrum((float) m_iStrumMs.get(), m_StrumDirection.get(), m_iStrumVelocityCurve.get() * 0.01f, m_iHumanize.get() * 0.01f);
+    const bool bArpeggiator = m_bArpeggiator.get();
+    m_arpeggiator.SetArpeggio(m_ArpPattern.get(), m_ArpRate.get(), m_iArpGate.get() * 0.01f);
+    const bool bMpe = m_bMpe.get();
+    KeyboardStateFifo* pKeyboardState = m_keyboardStateFifo.IsAttached() ? &m_keyboardStateFifo : nullptr;
     
     // End - Atomic Variable Access
     
-    if(chordType == Chords::Type::Invalid)
-        return;
+    // Where the block sits on the host's timeline, read once for the whole block
+    juce::AudioPlayHead::CurrentPositionInfo position;
+    juce::AudioPlayHead* pPlayHead = getPlayHead();
+    const bool bHasPosition = pPlayHead != nullptr && pPlayHead->getCurrentPosition(position);
+    m_arpeggiator.BeginBlock(bHasPosition ? &position : nullptr, m_iBlockStartSample, buffer.getNumSamples());
+    
+    // A newly opened editor starts with an empty keyboard, show it what is already held
+    if(pKeyboardState != nullptr && pKeyboardState->ShouldPublishHeldNotes())
+        m_chordVoices.ForEachChord([pKeyboardState](PressedChord& chord) { chord.PublishKeyboardState(true, *pKeyboardState); });
+    
+    if(chordType != Chords::Type::Invalid && HasChordInput(midiMessages, bMpe))
+    {
+        iNumChordNotes = ProcessMidi(midiMessages, chordType, scaleModel, quantizeMode, bDiatonicChords, bArpeggiator, bMpe, pKeyboardState);
+        iNumChordNotes += m_arpeggiator.RenderSteps(m_iBlockStartSample + buffer.getNumSamples(), m_noteScheduler);
+        m_noteScheduler.RenderBlock(m_iBlockStartSample, buffer.getNumSamples(), m_processedMidi);
+        
+        // Copied back rather than swapped, so the host's storage never ends up in m_processedMidi and
+        // the preallocated scratch buffer is never traded for a smaller one that would have to grow.
+        // The host's buffer still grows here if it holds less than the chords, see hostStorageCheck.
+        midiMessages.clear();
+        midiMessages.addEvents(m_processedMidi, 0, -1, 0);
+    }
+    else if(chordType != Chords::Type::Invalid)
+    {
+        // Nothing to take out of the input (CC automation, sysex...), it goes out as it came in with
+        // the notes due in this block (strum tails, arpeggiator steps, note-offs) added to it
+        iNumChordNotes = m_arpeggiator.RenderSteps(m_iBlockStartSample + buffer.getNumSamples(), m_noteScheduler);
+        m_noteScheduler.RenderBlock(m_iBlockStartSample, buffer.getNumSamples(), midiMessages);
+    }
+    
+    m_iBlockStartSample += buffer.getNumSamples();
     
-    for (juce::MidiBuffer::Iterator i (midiMessages); i.getNextEvent (m, iSamplePosition);)
+    ProcessingStats::Block block;
+    block.iTicks = juce::Time::getHighResolutionTicks() - iStartTicks;
+    block.iNumSamples = buffer.getNumSamples();
+    block.iInputEvents = iNumInputEvents;
+    block.iOutputEvents = midiMessages.getNumEvents();
+    block.iChordNotes = iNumChordNotes;
+    m_processingStats.Push(block);
+    
+    // Last thing in the block, scale models retired before this point are no longer in use
+    m_uNumProcessedBlocks += 1;
+}
+
+int MidiScalesPluginAudioProcessor::ProcessMidi(const juce::MidiBuffer& midiMessages, Chords::Type::eType chordType, const ScaleModel& scaleModel, Quantize::Mode::eMode quantizeMode, bool bDiatonicChords, bool bArpeggiator, bool bMpe, KeyboardStateFifo* pKeyboardState)
+{
+    // More incoming events than prepareToPlay reserved for, the scratch buffers will grow
+    jassert(GetScratchMidiBytes(midiMessages.getNumEvents()) <= m_uScratchMidiBytes);
+    
+    int iNumChordNotes = 0;
+    
+    const ChordNotes& chordTypeNotes = Helpers::GetChordSequence(chordType);
+    
+    for(const auto metadata : midiMessages)
     {
-        if(m.isNoteOn())
+        // Decoded straight from the buffer's bytes, no MidiMessage is built for an event
+        const juce::uint8* pData = metadata.data;
+        const int iSamplePosition = metadata.samplePosition;
+        const int iStatus = pData[0] & 0xf0;
+        const int iChannel = (pData[0] & 0x0f) + 1;
+        const bool bThreeBytes = metadata.numBytes >= 3;
+        // Data bytes are 7 bit, a malformed one would otherwise index past the note tables
+        const int iData1 = bThreeBytes ? pData[1] & 0x7f : 0;
+        const juce::uint8 uData2 = bThreeBytes ? (juce::uint8) (pData[2] & 0x7f) : 0;
+        
+        // Arpeggiator steps before this event play the chords held until now
+        iNumChordNotes += m_arpeggiator.RenderSteps(m_iBlockStartSample + iSamplePosition, m_noteScheduler);
+        
+        if(bThreeBytes && iStatus == 0x90 && uData2 != 0)
         {
-            if(m_currentChord.IsValid())
-            {
-                m_currentChord.GenerateMidi(false , iSamplePosition-1, m.getTimeStamp(), processedMidi, keyboardStateMidi);
-                m_currentChord.Reset();
-            }
+            // A repeated note-on for a held root note restarts its chord, the key holds it from now on, not the pedal
+            m_sustainTracker.Unlatch(iChannel, iData1);
+            if(PressedChord* pHeldChord = m_chordVoices.FindChord(iData1, iChannel))
+                EndChord(*pHeldChord, iSamplePosition, pKeyboardState);
             
-            const bool bIsNoteInScale = IsNoteInScaleSafe(m.getNoteNumber());
-            if(bIsNoteInScale)
+            // The note snapped to the scale, -1 if it isn't played. Chords stay keyed by the
+            // incoming note so its note-off finds them whatever the root became.
+            const int iRootNote = scaleModel.GetQuantizedNote(quantizeMode, iData1);
+            if(iRootNote >= 0)
             {
-                m_currentChord.Setup(m.getNoteNumber(), m.getChannel(), chordType, m.getVelocity(), m.getTimeStamp());
-                m_currentChord.GenerateMidi(true , iSamplePosition, m.getTimeStamp(), processedMidi, keyboardStateMidi);
+                // Steal the longest held chord when every voice is in use
+                if(m_chordVoices.IsFull())
+                    EndChord(*m_chordVoices.GetOldestChord(), iSamplePosition, pKeyboardState);
+                
+                PressedChord& chord = m_chordVoices.AddChord(iData1, iChannel);
+                // Diatonic chords take as many notes as the chord type has, fall back to the type itself if the scale can't stack any
+                const ChordNotes& diatonicNotes = scaleModel.GetDiatonicChord(iRootNote, chordTypeNotes.size());
+                const bool bDiatonicChord = bDiatonicChords && diatonicNotes.size() > 0;
+                const ChordNotes& chordNotes = bDiatonicChord ? diatonicNotes : chordTypeNotes;
+                const ChordInversions& inversions = bDiatonicChord ? scaleModel.GetDiatonicInversions(iRootNote, chordTypeNotes.size())
+                                                                   : m_chordVoicer.GetInversions(chordType);
+                
+                VoicedChord voicedChord;
+                m_chordVoicer.Voice(inversions, iRootNote, voicedChord);
+                
+                chord.Setup(iRootNote, iChannel, chordType, chordNotes, voicedChord, uData2, (double) iSamplePosition);
+                
+                // Every tone on a member channel of its own, starting from the finger's current expression
+                if(bMpe)
+                {
+                    juce::uint8 toneChannels[CHORD_MAX_NOTES] = {};
+                    m_mpeRouter.AllocateChannels(chord.GetNumNotes(), m_noteScheduler, toneChannels);
+                    m_mpeRouter.SendExpression(iChannel, toneChannels, chord.GetNumNotes(), iSamplePosition, m_processedMidi);
+                    chord.SetMpeChannels(toneChannels);
+                }
+                
+                // The arpeggiator plays its notes from the next step on, the keyboard shows the chord straight away
+                if(bArpeggiator)
+                {
+                    m_arpeggiator.AddChord(chord);
+                    if(pKeyboardState != nullptr)
+                        chord.PublishKeyboardState(true, *pKeyboardState);
+                }
+                else
+                {
+                    StrummedNotes strummedNotes;
+                    m_chordStrummer.Strum(chord.GetNumNotes(), uData2, strummedNotes);
+                    chord.SetStrum(strummedNotes);
+                    chord.GenerateMidi(true, m_iBlockStartSample + iSamplePosition, m_noteScheduler, pKeyboardState);
+                    iNumChordNotes += chord.GetNumNotes();
+                }
             }
-            else
+            else if(pKeyboardState != nullptr)
             {
                 // Generate UI Message
-                juce::MidiMessage k = juce::MidiMessage::noteOn(KEYBOARD_UI_NOTE_CHANNEL, m.getNoteNumber() % SCALES_DOUBLE_OCTAVE_STEPS, m.getVelocity());
-                k.setTimeStamp(m.getTimeStamp());
-                keyboardStateMidi.addEvent(k, iSamplePosition);
+                pKeyboardState->Push(KEYBOARD_UI_NOTE_CHANNEL, iData1 % SCALES_DOUBLE_OCTAVE_STEPS, uData2);
             }
         }
-        else if(m.isNoteOff())
+        else if(bThreeBytes && (iStatus == 0x80 || iStatus == 0x90))
         {
-            if(m_currentChord.IsValid() && m_currentChord.GetRootNote() == m.getNoteNumber())
+            if(PressedChord* pChord = m_chordVoices.FindChord(iData1, iChannel))
             {
-                m_currentChord.GenerateMidi(false, iSamplePosition, m.getTimeStamp(), processedMidi, keyboardStateMidi);
-                m_currentChord.Reset();
+                // The pedal holds the chord until it comes up
+                if(m_sustainTracker.IsPedalDown(iChannel))
+                    m_sustainTracker.Latch(iChannel, iData1);
+                else
+                    EndChord(*pChord, iSamplePosition, pKeyboardState);
             }
-            
-            const bool bIsNoteInScale = IsNoteInScaleSafe(m.getNoteNumber());
-            if(!bIsNoteInScale)
+            else if(pKeyboardState != nullptr)
             {
                 // Generate UI Message
-                juce::MidiMessage k = juce::MidiMessage::noteOff(KEYBOARD_UI_NOTE_CHANNEL, m.getNoteNumber() % SCALES_DOUBLE_OCTAVE_STEPS, uint8_t(0));
-                k.setTimeStamp(m.getTimeStamp());
-                keyboardStateMidi.addEvent(k, iSamplePosition);
+                pKeyboardState->Push(KEYBOARD_UI_NOTE_CHANNEL, iData1 % SCALES_DOUBLE_OCTAVE_STEPS, 0);
+            }
+        }
+        else if(bThreeBytes && iStatus == 0xb0 && iData1 == SUSTAIN_PEDAL_CONTROLLER)
+        {
+            // Not passed on, a synth holding the chord notes as well would keep them past the chords' ends.
+            // With MPE the pedal is on the master channel and holds every member channel.
+            const bool bPedalDown = uData2 >= SUSTAIN_PEDAL_DOWN_VALUE;
+            const bool bZonePedal = bMpe && iChannel == MPE_MASTER_CHANNEL;
+            const int iFirstChannel = bZonePedal ? 1 : iChannel;
+            const int iLastChannel = bZonePedal ? MIDI_CHANNELS : iChannel;
+            
+            for(int iPedalChannel = iFirstChannel; iPedalChannel <= iLastChannel; iPedalChannel++)
+            {
+                m_sustainTracker.SetPedalDown(iPedalChannel, bPedalDown);
+                if(!bPedalDown)
+                    ReleaseSustainedChords(iPedalChannel, iSamplePosition, pKeyboardState);
             }
         }
+        else if(bMpe && m_mpeRouter.UpdateExpression(pData, metadata.numBytes))
+        {
+            // Zone-wide on the master channel, otherwise only the tones of the chord this finger started
+            if(iChannel == MPE_MASTER_CHANNEL)
+            {
+                m_processedMidi.addEvent(pData, metadata.numBytes, iSamplePosition);
+            }
+            else if(PressedChord* pChord = m_chordVoices.FindChannelChord(iChannel))
+            {
+                if(pChord->IsMpe())
+                    MpeRouter::ForwardExpression(pData, metadata.numBytes, pChord->GetToneChannels(), pChord->GetNumNotes(), iSamplePosition, m_processedMidi);
+            }
+        }
+        else
+        {
+            // Controllers, pitch bend, program changes, sysex... go out in order, ahead of chord notes at the same sample
+            m_processedMidi.addEvent(pData, metadata.numBytes, iSamplePosition);
+        }
+    }
+    
+    return iNumChordNotes;
+}
+
+bool MidiScalesPluginAudioProcessor::HasChordInput(const juce::MidiBuffer& midiMessages, bool bMpe)
+{
+    for(const auto metadata : midiMessages)
+    {
+        const int iStatus = metadata.data[0] & 0xf0;
+        
+        if(iStatus == 0x80 || iStatus == 0x90)
+            return true;
+        
+        if(iStatus == 0xb0 && metadata.numBytes > 1 && metadata.data[1] == SUSTAIN_PEDAL_CONTROLLER)
+            return true;
+        
+        if(bMpe && (iStatus == 0xd0 || iStatus == 0xe0 || (iStatus == 0xb0 && metadata.numBytes > 1 && metadata.data[1] == MPE_TIMBRE_CONTROLLER)))
+            return true;
+    }
+    
+    return false;
+}
+
+int MidiScalesPluginAudioProcessor::GetMaxChordNoteEvents(int iNumInputEvents)
+{
+    // Worst case every incoming event is a note that starts or ends a full chord, plus
+    // the chords still held from previous blocks
+    return (2 * iNumInputEvents + CHORD_MAX_VOICES) * CHORD_MAX_NOTES;
+}
+
+size_t MidiScalesPluginAudioProcessor::GetScratchMidiBytes(int iNumInputEvents)
+{
+    // With MPE every incoming event can also set the expression of a full chord's channels. Events
+    // passed through are counted as the chord notes they didn't start, sysex longer than a note aside.
+    const int iMaxExpressionEvents = iNumInputEvents * CHORD_MAX_NOTES * MPE_NOTE_EXPRESSION_MESSAGES;
+    return (size_t) (GetMaxChordNoteEvents(iNumInputEvents) + iMaxExpressionEvents) * MIDI_BUFFER_NOTE_EVENT_BYTES;
+}
+
+void MidiScalesPluginAudioProcessor::EndChord(PressedChord& chord, int iSamplePosition, KeyboardStateFifo* pKeyboardState)
+{
+    // An arpeggiated chord has no notes of its own, the note-offs of its steps are already scheduled
+    if(m_arpeggiator.RemoveChord(chord))
+    {
+        if(pKeyboardState != nullptr)
+            chord.PublishKeyboardState(false, *pKeyboardState);
     }
+    else
+    {
+        chord.GenerateMidi(false, m_iBlockStartSample + iSamplePosition, m_noteScheduler, pKeyboardState);
+    }
+    
+    if(chord.IsMpe())
+        m_mpeRouter.ReleaseChannels(chord.GetToneChannels(), chord.GetNumNotes());
     
-    midiMessages.swapWith (processedMidi);
-    m_keyboardState.processNextMidiBuffer (keyboardStateMidi, 0, buffer.getNumSamples(), true);
+    m_chordVoices.RemoveChord(chord);
+}
+
+void MidiScalesPluginAudioProcessor::ReleaseSustainedChords(int iChannel, int iSamplePosition, KeyboardStateFifo* pKeyboardState)
+{
+    juce::uint8 latchedNotes[SCALES_TOTAL_STEPS];
+    const int iNumLatched = m_sustainTracker.TakeLatched(iChannel, latchedNotes);
+    
+    // A latched key's chord may have been stolen for another since
+    for(int i = 0; i < iNumLatched; i++)
+    {
+        if(PressedChord* pChord = m_chordVoices.FindChord(latchedNotes[i], iChannel))
+            EndChord(*pChord, iSamplePosition, pKeyboardState);
+    }
 }
 
 //==============================================================================
@@ -214,40 +472,232 @@ juce::AudioProcessorEditor* MidiScalesPluginAudioProcessor::createEditor()
 //==============================================================================
 void MidiScalesPluginAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    juce::uint8 state[PluginState::Byte::Total];
+    
+    state[PluginState::Byte::Magic] = PLUGIN_STATE_MAGIC;
+    state[PluginState::Byte::Version] = PLUGIN_STATE_VERSION;
+    state[PluginState::Byte::ScaleNote] = (juce::uint8) (juce::int8) GetScaleNote();
+    state[PluginState::Byte::ScaleType] = (juce::uint8) (GetScaleTypeToSave() & 0xff);
+    state[PluginState::Byte::ChordType] = (juce::uint8) (GetChordTypeToSave() & 0xff);
+    state[PluginState::Byte::ScaleTypeHigh] = (juce::uint8) (GetScaleTypeToSave() >> 8);
+    state[PluginState::Byte::ChordTypeHigh] = (juce::uint8) (GetChordTypeToSave() >> 8);
+    state[PluginState::Byte::QuantizeMode] = (juce::uint8) m_QuantizeMode.get();
+    state[PluginState::Byte::DiatonicChords] = m_bDiatonicChords.get() ? 1 : 0;
+    state[PluginState::Byte::VoicingMode] = (juce::uint8) m_VoicingMode.get();
+    state[PluginState::Byte::VoicingLowNote] = (juce::uint8) m_iVoicingLowNote.get();
+    state[PluginState::Byte::VoicingHighNote] = (juce::uint8) m_iVoicingHighNote.get();
+    state[PluginState::Byte::StrumMs] = (juce::uint8) m_iStrumMs.get();
+    state[PluginState::Byte::StrumDirection] = (juce::uint8) m_StrumDirection.get();
+    state[PluginState::Byte::StrumVelocityCurve] = (juce::uint8) (m_iStrumVelocityCurve.get() + 100);
+    state[PluginState::Byte::Humanize] = (juce::uint8) m_iHumanize.get();
+    state[PluginState::Byte::Arpeggiator] = m_bArpeggiator.get() ? 1 : 0;
+    state[PluginState::Byte::ArpPattern] = (juce::uint8) m_ArpPattern.get();
+    state[PluginState::Byte::ArpRate] = (juce::uint8) m_ArpRate.get();
+    state[PluginState::Byte::ArpGate] = (juce::uint8) m_iArpGate.get();
+    state[PluginState::Byte::Mpe] = m_bMpe.get() ? 1 : 0;
+    state[PluginState::Byte::Sharps] = m_pScaleModel->UsesSharps() ? 1 : 0;
+    
+    destData.replaceWith(state, sizeof(state));
 }
 
+// Never touches the audio thread's data directly, everything goes through the same
+// atomic stores as the editor. Fields that are missing, newer than the blob's version
+// or out of range for this build keep their current values.
 void MidiScalesPluginAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    const juce::uint8* pState = static_cast<const juce::uint8*> (data);
+    
+    if(pState == nullptr || sizeInBytes <= PluginState::Byte::Version || pState[PluginState::Byte::Magic] != PLUGIN_STATE_MAGIC
+       || pState[PluginState::Byte::Version] == 0)
+        return;
+    
+    // Newer versions only append fields, the ones this build knows are read as the current version's
+    const int iVersion = juce::jmin((int) pState[PluginState::Byte::Version], PLUGIN_STATE_VERSION);
+    
+    auto hasField = [sizeInBytes, iVersion](PluginState::Byte::eByte field)
+    {
+        return field < sizeInBytes && Helpers::GetStateFieldVersion(field) <= iVersion;
+    };
+    
+    int iScaleNote = GetScaleNote();
+    Scales::Type::eType scaleType = GetScaleType();
+    bool bSharps = m_pScaleModel->UsesSharps();
+    Chords::Type::eType chordType = m_ChordType.get();
+    Quantize::Mode::eMode quantizeMode = m_QuantizeMode.get();
+    bool bDiatonicChords = m_bDiatonicChords.get();
+    Voicing::Mode::eMode voicingMode = m_VoicingMode.get();
+    int iVoicingLowNote = m_iVoicingLowNote.get();
+    int iVoicingHighNote = m_iVoicingHighNote.get();
+    int iStrumMs = m_iStrumMs.get();
+    Strum::Direction::eDirection strumDirection = m_StrumDirection.get();
+    int iStrumVelocityCurve = m_iStrumVelocityCurve.get();
+    int iHumanize = m_iHumanize.get();
+    bool bArpeggiator = m_bArpeggiator.get();
+    Arpeggio::Pattern::ePattern arpPattern = m_ArpPattern.get();
+    Arpeggio::Rate::eRate arpRate = m_ArpRate.get();
+    int iArpGate = m_iArpGate.get();
+    bool bMpe = m_bMpe.get();
+    int iUnresolvedScaleType = 0;
+    int iUnresolvedChordType = 0;
+    
+    if(hasField(PluginState::Byte::ScaleNote))
+    {
+        const int iValue = (juce::int8) pState[PluginState::Byte::ScaleNote];
+        if(iValue >= 0 && iValue < SCALES_OCTAVE_STEPS)
+            iScaleNote = iValue;
+    }
+    
+    if(hasField(PluginState::Byte::ScaleType))
+    {
+        int iValue = pState[PluginState::Byte::ScaleType];
+        if(hasField(PluginState::Byte::ScaleTypeHigh))
+            iValue |= pState[PluginState::Byte::ScaleTypeHigh] << 8;
+        
+        if(ScaleLibrary::GetInstance().IsValidScale(iValue))
+            scaleType = (Scales::Type::eType) iValue;
+        else
+            iUnresolvedScaleType = iValue;
+    }
+    
+    if(hasField(PluginState::Byte::ChordType))
+    {
+        int iValue = pState[PluginState::Byte::ChordType];
+        if(hasField(PluginState::Byte::ChordTypeHigh))
+            iValue |= pState[PluginState::Byte::ChordTypeHigh] << 8;
+        
+        if(ScaleLibrary::GetInstance().IsValidChord(iValue))
+            chordType = (Chords::Type::eType) iValue;
+        else
+            iUnresolvedChordType = iValue;
+    }
+    
+    if(hasField(PluginState::Byte::QuantizeMode))
+    {
+        const int iValue = pState[PluginState::Byte::QuantizeMode];
+        if(iValue < Quantize::Mode::Total)
+            quantizeMode = (Quantize::Mode::eMode) iValue;
+    }
+    
+    if(hasField(PluginState::Byte::DiatonicChords))
+        bDiatonicChords = pState[PluginState::Byte::DiatonicChords] != 0;
+    
+    if(hasField(PluginState::Byte::VoicingMode))
+    {
+        const int iValue = pState[PluginState::Byte::VoicingMode];
+        if(iValue < Voicing::Mode::Total)
+            voicingMode = (Voicing::Mode::eMode) iValue;
+    }
+    
+    if(hasField(PluginState::Byte::VoicingHighNote))
+    {
+        const int iLowNote = pState[PluginState::Byte::VoicingLowNote];
+        const int iHighNote = pState[PluginState::Byte::VoicingHighNote];
+        if(iHighNote < SCALES_TOTAL_STEPS && iHighNote - iLowNote >= VOICING_MIN_REGISTER_STEPS)
+        {
+            iVoicingLowNote = iLowNote;
+            iVoicingHighNote = iHighNote;
+        }
+    }
+    
+    if(hasField(PluginState::Byte::Humanize))
+    {
+        const int iDirection = pState[PluginState::Byte::StrumDirection];
+        if(iDirection < Strum::Direction::Total)
+            strumDirection = (Strum::Direction::eDirection) iDirection;
+        
+        iStrumMs = juce::jmin((int) pState[PluginState::Byte::StrumMs], STRUM_MAX_NOTE_MS);
+        iStrumVelocityCurve = juce::jlimit(-100, 100, pState[PluginState::Byte::StrumVelocityCurve] - 100);
+        iHumanize = juce::jmin((int) pState[PluginState::Byte::Humanize], 100);
+    }
+    
+    if(hasField(PluginState::Byte::ArpGate))
+    {
+        bArpeggiator = pState[PluginState::Byte::Arpeggiator] != 0;
+        
+        const int iPattern = pState[PluginState::Byte::ArpPattern];
+        if(iPattern < Arpeggio::Pattern::Total)
+            arpPattern = (Arpeggio::Pattern::ePattern) iPattern;
+        
+        const int iRate = pState[PluginState::Byte::ArpRate];
+        if(iRate < Arpeggio::Rate::Total)
+            arpRate = (Arpeggio::Rate::eRate) iRate;
+        
+        iArpGate = juce::jlimit(1, 100, (int) pState[PluginState::Byte::ArpGate]);
+    }
+    
+    if(hasField(PluginState::Byte::Mpe))
+        bMpe = pState[PluginState::Byte::Mpe] != 0;
+    
+    if(hasField(PluginState::Byte::Sharps))
+        bSharps = pState[PluginState::Byte::Sharps] != 0;
+    
+    SetScaleSafe(iScaleNote, scaleType, bSharps);
+    m_ChordType.set(chordType);
+    m_QuantizeMode.set(quantizeMode);
+    m_bDiatonicChords.set(bDiatonicChords);
+    m_VoicingMode.set(voicingMode);
+    m_iVoicingLowNote.set(iVoicingLowNote);
+    m_iVoicingHighNote.set(iVoicingHighNote);
+    m_iStrumMs.set(iStrumMs);
+    m_StrumDirection.set(strumDirection);
+    m_iStrumVelocityCurve.set(iStrumVelocityCurve);
+    m_iHumanize.set(iHumanize);
+    m_bArpeggiator.set(bArpeggiator);
+    m_ArpPattern.set(arpPattern);
+    m_ArpRate.set(arpRate);
+    m_iArpGate.set(iArpGate);
+    m_bMpe.set(bMpe);
+    
+    m_iUnresolvedScaleType = iUnresolvedScaleType;
+    m_iUnresolvedChordType = iUnresolvedChordType;
+    m_unresolvedScaleFallback = scaleType;
+    m_unresolvedChordFallback = chordType;
+}
+
+int MidiScalesPluginAudioProcessor::GetScaleTypeToSave() const
+{
+    return m_iUnresolvedScaleType != 0 && GetScaleType() == m_unresolvedScaleFallback ? m_iUnresolvedScaleType : GetScaleType();
 }
 
+int MidiScalesPluginAudioProcessor::GetChordTypeToSave() const
+{
+    return m_iUnresolvedChordType != 0 && m_ChordType.get() == m_unresolvedChordFallback ? m_iUnresolvedChordType : m_ChordType.get();
+}
+
+// Called from the message thread. The scale is built here and published to the
+// audio thread as a single atomic store, so processBlock never waits on it.
 void MidiScalesPluginAudioProcessor::SetScaleSafe(int iScaleNote, Scales::Type::eType scaleType)
 {
-    juce::ScopedLock lock(m_ScalesLock);
+    SetScaleSafe(iScaleNote, scaleType, m_pScaleModel == nullptr || m_pScaleModel->UsesSharps());
+}
+
+void MidiScalesPluginAudioProcessor::SetScaleSafe(int iScaleNote, Scales::Type::eType scaleType, bool bSharps)
+{
+    ReleaseRetiredScaleModels();
     
-    m_iScaleNote = iScaleNote;
-    m_ScaleType = scaleType;
+    ScaleModel::Ptr pPreviousScaleModel = m_pScaleModel;
+    m_pScaleModel = ScaleModel::Create(iScaleNote, scaleType, bSharps);
+    m_pAudioScaleModel.set(m_pScaleModel.get());
     
-    Helpers::GetScaleSequence(m_ScaleType, m_ScaleNotes);
-    const int iNumNotes = m_ScaleNotes.size();
+    if(pPreviousScaleModel != nullptr)
+        m_retiredScaleModels.add({ pPreviousScaleModel, m_uNumProcessedBlocks.get() });
+}
+
+void MidiScalesPluginAudioProcessor::ReleaseRetiredScaleModels()
+{
+    // A block that could have read a retired model has completed once the counter moved on
+    const juce::uint32 uNumProcessedBlocks = m_uNumProcessedBlocks.get();
     
-    if(m_iScaleNote >= 0)
+    for(int i = m_retiredScaleModels.size() - 1; i >= 0; i--)
     {
-        for(int i=0; i<iNumNotes; i++)
-        {
-            m_ScaleNotes.set(i, (m_ScaleNotes[i] + m_iScaleNote) % SCALES_OCTAVE_STEPS);
-        }
+        if(m_retiredScaleModels.getReference(i).uRetiredAtBlock != uNumProcessedBlocks)
+            m_retiredScaleModels.remove(i);
     }
 }
 
-bool MidiScalesPluginAudioProcessor::IsNoteInScaleSafe(int iMidiNote)
+bool MidiScalesPluginAudioProcessor::IsNoteInScaleSafe(int iMidiNote) const
 {
-    juce::ScopedLock lock(m_ScalesLock);
-    return  m_ScaleNotes.contains(iMidiNote % SCALES_OCTAVE_STEPS);
+    return m_pScaleModel->Contains(iMidiNote);
 }
 
 //==============================================================================
@@ -10,6 +10,18 @@
 
 #include "Utilities.h"
 #include "PressedChord.h"
+#include "ChordVoiceTable.h"
+#include "MidiNoteScheduler.h"
+#include "KeyboardStateFifo.h"
+#include "RealtimeAllocations.h"
+#include "ProcessingStats.h"
+#include "ScaleLibrary.h"
+#include "ScaleModel.h"
+#include "ChordVoicer.h"
+#include "ChordStrummer.h"
+#include "Arpeggiator.h"
+#include "MpeRouter.h"
+#include "SustainTracker.h"
 
 //==============================================================================
 /**
@@ -55,18 +67,95 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
     
+    // Message thread. Builds the new ScaleModel and publishes it to the audio thread,
+    // the first overload keeps the current sharps/flats spelling.
     void SetScaleSafe(int iScaleNote, Scales::Type::eType scaleType);
-    bool IsNoteInScaleSafe(int iMidiNote);
+    void SetScaleSafe(int iScaleNote, Scales::Type::eType scaleType, bool bSharps);
+    // Message thread. Frees the replaced models the audio thread is done with, called by
+    // SetScaleSafe and periodically so they don't wait for the next scale change.
+    void ReleaseRetiredScaleModels();
+    bool IsNoteInScaleSafe(int iMidiNote) const;
+    ScaleModel::Ptr GetScaleModel() const { return m_pScaleModel; }
+    int GetScaleNote() const { return m_pScaleModel->GetScaleNote(); }
+    Scales::Type::eType GetScaleType() const { return m_pScaleModel->GetScaleType(); }
     
-    juce::MidiKeyboardState m_keyboardState;
     juce::Atomic<Chords::Type::eType> m_ChordType;
+    juce::Atomic<Quantize::Mode::eMode> m_QuantizeMode;
+    // Chords are stacked from the scale's degrees, m_ChordType only picks how many notes
+    juce::Atomic<bool> m_bDiatonicChords;
+    // Voice leading keeps chord notes between the low and high note
+    juce::Atomic<Voicing::Mode::eMode> m_VoicingMode;
+    juce::Atomic<int> m_iVoicingLowNote;
+    juce::Atomic<int> m_iVoicingHighNote;
+    // Strum: ms between chord notes, the last note's velocity change in percent, humanize amount in percent
+    juce::Atomic<int> m_iStrumMs;
+    juce::Atomic<Strum::Direction::eDirection> m_StrumDirection;
+    juce::Atomic<int> m_iStrumVelocityCurve;
+    juce::Atomic<int> m_iHumanize;
+    // Arpeggiator: chords started while it is on play one note per step, gate in percent of a step
+    juce::Atomic<bool> m_bArpeggiator;
+    juce::Atomic<Arpeggio::Pattern::ePattern> m_ArpPattern;
+    juce::Atomic<Arpeggio::Rate::eRate> m_ArpRate;
+    juce::Atomic<int> m_iArpGate;
+    // MPE: every chord tone on a member channel of its own, with the expression of the finger that started the chord
+    juce::Atomic<bool> m_bMpe;
+    
+    // Note changes for the editor's keyboard, the editor attaches while it is open
+    KeyboardStateFifo m_keyboardStateFifo;
+    
+    // Written by processBlock, read by a single consumer (the editor or a headless tool)
+    ProcessingStats m_processingStats;
+    
+    // Bytes a MidiBuffer passed to processBlock needs for processBlock never to grow it, valid after prepareToPlay
+    size_t GetMidiBufferBytes() const { return m_uScratchMidiBytes; }
 
 private:
-    juce::CriticalSection m_ScalesLock;
-    int m_iScaleNote;
-    Scales::Type::eType m_ScaleType;
-    PressedChord m_currentChord;
-    ScaleNotes m_ScaleNotes;
+    // True if the block has events ProcessMidi turns into chords (notes, the sustain pedal, and expression with MPE on)
+    static bool HasChordInput(const juce::MidiBuffer& midiMessages, bool bMpe);
+    // Returns the number of chord notes started, every event that isn't turned into chords is copied to m_processedMidi
+    int ProcessMidi(const juce::MidiBuffer& midiMessages, Chords::Type::eType chordType, const ScaleModel& scaleModel, Quantize::Mode::eMode quantizeMode, bool bDiatonicChords, bool bArpeggiator, bool bMpe, KeyboardStateFifo* pKeyboardState);
+    void EndChord(PressedChord& chord, int iSamplePosition, KeyboardStateFifo* pKeyboardState);
+    // Ends the chords of the keys released while the channel's pedal was down
+    void ReleaseSustainedChords(int iChannel, int iSamplePosition, KeyboardStateFifo* pKeyboardState);
+    static int GetMaxChordNoteEvents(int iNumInputEvents);
+    static size_t GetScratchMidiBytes(int iNumInputEvents);
+    // The stored ID while the restored fallback is still selected, so a session isn't saved without it
+    int GetScaleTypeToSave() const;
+    int GetChordTypeToSave() const;
+    
+    // Current scale for the message thread, and the same model as the audio thread reads
+    // it (wait-free, once per block). A replaced model is retired rather than released until
+    // the audio thread has finished the block that may still be using it.
+    struct RetiredScaleModel
+    {
+        ScaleModel::Ptr pScaleModel;
+        juce::uint32 uRetiredAtBlock;
+    };
+    
+    ScaleModel::Ptr m_pScaleModel;
+    
+    // Message thread. Library IDs a restored session used that the loaded library doesn't have
+    // (e.g. its .mslib is missing), 0 if none, and the types that were selected instead.
+    int m_iUnresolvedScaleType;
+    int m_iUnresolvedChordType;
+    Scales::Type::eType m_unresolvedScaleFallback;
+    Chords::Type::eType m_unresolvedChordFallback;
+    juce::Atomic<ScaleModel*> m_pAudioScaleModel;
+    juce::Array<RetiredScaleModel> m_retiredScaleModels;
+    juce::Atomic<juce::uint32> m_uNumProcessedBlocks;
+    ChordVoiceTable m_chordVoices;
+    ChordVoicer m_chordVoicer;
+    ChordStrummer m_chordStrummer;
+    Arpeggiator m_arpeggiator;
+    MpeRouter m_mpeRouter;
+    SustainTracker m_sustainTracker;
+    MidiNoteScheduler m_noteScheduler;
+    // Absolute sample position of the current block, the scheduler's time base
+    juce::int64 m_iBlockStartSample;
+    
+    // Scratch buffers reused by every processBlock, sized in prepareToPlay
+    juce::MidiBuffer m_processedMidi;
+    size_t m_uScratchMidiBytes;
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiScalesPluginAudioProcessor)
@@ -12,13 +12,11 @@
 
 PressedChord::PressedChord()
 {
-    m_notesPressed.ensureStorageAllocated(CHORD_MAX_NOTES);
     Reset();
 }
 
 PressedChord::~PressedChord()
 {
-    m_notesPressed.clear();
 }
 
 void PressedChord::Reset()
@@ -28,15 +26,29 @@ void PressedChord::Reset()
     m_dTimeStamp = 0;
     m_uVelocity = 0;
     m_iChannel = -1;
-    m_notesPressed.clearQuick();
+    m_chordNotes = Helpers::GetChordSequence(Chords::Type::Invalid);
+    m_voicedChord.numNotes = 0;
+    m_iNoteOnSampleTime = 0;
+    m_bMpe = false;
+    m_iSourceId = 0;
 }
 
 bool PressedChord::IsValid()
 {
-    return m_iRootNote > 0 && m_iRootNote < SCALES_TOTAL_STEPS && m_notesPressed.size() > 0 && m_iChannel >= 0;
+    return m_iRootNote >= 0 && m_iRootNote < SCALES_TOTAL_STEPS && m_voicedChord.size() > 0 && m_iChannel >= 0;
 }
 
 void PressedChord::Setup(int iRootNote, int iChannel, Chords::Type::eType eChordType, juce::uint8 uVelocity, double dTimeStamp)
+{
+    const ChordNotes& chordNotes = Helpers::GetChordSequence(eChordType);
+    
+    VoicedChord voicedChord;
+    ChordVoicer::VoiceRootPosition(chordNotes, iRootNote, voicedChord);
+    
+    Setup(iRootNote, iChannel, eChordType, chordNotes, voicedChord, uVelocity, dTimeStamp);
+}
+
+void PressedChord::Setup(int iRootNote, int iChannel, Chords::Type::eType eChordType, const ChordNotes& chordNotes, const VoicedChord& voicedChord, juce::uint8 uVelocity, double dTimeStamp)
 {
     m_eChordType = eChordType;
     m_iRootNote = iRootNote;
@@ -44,55 +56,68 @@ void PressedChord::Setup(int iRootNote, int iChannel, Chords::Type::eType eChord
     m_uVelocity = uVelocity;
     m_iChannel = iChannel;
     
-    Helpers::GetChordSequence(eChordType, m_notesPressed);
+    m_chordNotes = chordNotes;
+    m_voicedChord = voicedChord;
+    
+    for(int i = 0; i < CHORD_MAX_NOTES; i++)
+    {
+        m_strummedNotes.offsets[i] = 0;
+        m_strummedNotes.velocities[i] = uVelocity;
+        m_toneChannels[i] = (juce::uint8) iChannel;
+    }
+    
+    m_bMpe = false;
+}
+
+void PressedChord::SetStrum(const StrummedNotes& strummedNotes)
+{
+    m_strummedNotes = strummedNotes;
+}
+
+void PressedChord::SetMpeChannels(const juce::uint8* pToneChannels)
+{
+    std::memcpy(m_toneChannels, pToneChannels, sizeof(m_toneChannels));
+    m_bMpe = true;
 }
 
-void PressedChord::GenerateMidi(bool bNoteOnOff, int iSamplePosition, double fCurrentTimeStamp, juce::MidiBuffer& processedMidi, juce::MidiBuffer& keyboardStateMidi)
+void PressedChord::GenerateMidi(bool bNoteOnOff, juce::int64 iSampleTime, MidiNoteScheduler& noteScheduler, KeyboardStateFifo* pKeyboardState)
 {
     if(!IsValid())
         return;
     
-    const juce::uint8 uZeroVelocity = 0;
+    if(bNoteOnOff)
+        m_iNoteOnSampleTime = iSampleTime;
     
-    for(auto iChordNote : m_notesPressed)
+    for(int i = 0; i < m_voicedChord.size(); i++)
     {
-        juce::MidiMessage p, k;
+        const int iNote = m_voicedChord.notes[i];
+        const juce::int64 iNoteOnSampleTime = m_iNoteOnSampleTime + m_strummedNotes.offsets[i];
         
         if(bNoteOnOff)
         {
-            p = juce::MidiMessage::noteOn(m_iChannel, (m_iRootNote + iChordNote) % SCALES_TOTAL_STEPS , m_uVelocity);
-            p.setTimeStamp(fCurrentTimeStamp);
-            processedMidi.addEvent (p, iSamplePosition);
-            
-            k = juce::MidiMessage::noteOn(KEYBOARD_UI_CHORD_CHANNEL, ((m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS) + iChordNote) % SCALES_OCTAVE_STEPS_RANGE, m_uVelocity);
-            k.setTimeStamp(m_dTimeStamp);
-            keyboardStateMidi.addEvent(k, iSamplePosition);
+            noteScheduler.ScheduleNoteOn(iNoteOnSampleTime, m_toneChannels[i], iNote, m_strummedNotes.velocities[i], GetSourceId());
         }
         else
         {
-            p = juce::MidiMessage::noteOff(m_iChannel, (m_iRootNote + iChordNote) % SCALES_TOTAL_STEPS , uZeroVelocity);
-            p.setTimeStamp(fCurrentTimeStamp);
-            processedMidi.addEvent (p, iSamplePosition);
-            
-            k = juce::MidiMessage::noteOff(KEYBOARD_UI_CHORD_CHANNEL, ((m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS) + iChordNote) % SCALES_OCTAVE_STEPS_RANGE, uZeroVelocity);
-            k.setTimeStamp(fCurrentTimeStamp);
-            keyboardStateMidi.addEvent(k, iSamplePosition);
+            // Released before a strummed note started, it still gets its sample of sound (an off at
+            // the same sample would be rendered before the on and leave the note hanging)
+            noteScheduler.ScheduleNoteOff(juce::jmax(iSampleTime, iNoteOnSampleTime + 1), m_toneChannels[i], iNote, GetSourceId());
         }
-
     }
     
-    juce::MidiMessage k;
+    if(pKeyboardState != nullptr)
+        PublishKeyboardState(bNoteOnOff, *pKeyboardState);
+}
+
+void PressedChord::PublishKeyboardState(bool bNoteOnOff, KeyboardStateFifo& keyboardState)
+{
+    if(!IsValid())
+        return;
+    
+    const juce::uint8 uVelocity = bNoteOnOff ? juce::jmax((juce::uint8) 1, m_uVelocity) : 0;
     
-    if(bNoteOnOff)
-    {
-        k = juce::MidiMessage::noteOn(KEYBOARD_UI_NOTE_CHANNEL, m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS, m_uVelocity);
-        k.setTimeStamp(m_dTimeStamp);
-    }
-    else
-    {
-        k = juce::MidiMessage::noteOff(KEYBOARD_UI_NOTE_CHANNEL, m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS, uZeroVelocity);
-        k.setTimeStamp(fCurrentTimeStamp);
-    }
+    for(int iChordNote : m_chordNotes)
+        keyboardState.Push(KEYBOARD_UI_CHORD_CHANNEL, ((m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS) + iChordNote) % SCALES_OCTAVE_STEPS_RANGE, uVelocity);
     
-    keyboardStateMidi.addEvent(k, iSamplePosition);
+    keyboardState.Push(KEYBOARD_UI_NOTE_CHANNEL, m_iRootNote % SCALES_DOUBLE_OCTAVE_STEPS, uVelocity);
 }
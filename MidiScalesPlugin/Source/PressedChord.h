@@ -10,6 +10,10 @@
 
 #pragma once
 #include "Utilities.h"
+#include "MidiNoteScheduler.h"
+#include "KeyboardStateFifo.h"
+#include "ChordVoicer.h"
+#include "ChordStrummer.h"
 
 class PressedChord
 {
@@ -20,17 +24,48 @@ public:
     void Reset();
     bool IsValid();
 
+    // Root position
     void Setup(int iRootNote, int iChannel, Chords::Type::eType eChordType, juce::uint8 uVelocity, double dTimeStamp);
+    // chordNotes is the shape shown on the keyboard, possibly built from the scale (see ScaleModel::GetDiatonicChord)
+    // with eChordType the type it stands in for, voicedChord the notes that are played (see ChordVoicer)
+    void Setup(int iRootNote, int iChannel, Chords::Type::eType eChordType, const ChordNotes& chordNotes, const VoicedChord& voicedChord, juce::uint8 uVelocity, double dTimeStamp);
+    // Spreads the note-ons out, Setup() starts every note at once with the chord's velocity
+    void SetStrum(const StrummedNotes& strummedNotes);
+    // One output channel per voiced note (see MpeRouter), Setup() plays every note on the input channel
+    void SetMpeChannels(const juce::uint8* pToneChannels);
     // bNoteOnOff: TRUE -> On, FALSE -> Off
-    void GenerateMidi(bool bNoteOnOff, int iSamplePosition, double fCurrentTimeStamp, juce::MidiBuffer& processedMidi, juce::MidiBuffer& keyboardStateMidi);
+    // Chord notes are queued on the scheduler at iSampleTime, the keyboard UI notes go to pKeyboardState (nullptr when no editor is open)
+    void GenerateMidi(bool bNoteOnOff, juce::int64 iSampleTime, MidiNoteScheduler& noteScheduler, KeyboardStateFifo* pKeyboardState);
+    void PublishKeyboardState(bool bNoteOnOff, KeyboardStateFifo& keyboardState);
     
     int GetRootNote() const { return m_iRootNote; }
+    int GetNumNotes() const { return m_voicedChord.size(); }
+    const VoicedChord& GetVoicedChord() const { return m_voicedChord; }
+    int GetChannel() const { return m_iChannel; }
+    bool IsMpe() const { return m_bMpe; }
+    // Output channel per voiced note
+    const juce::uint8* GetToneChannels() const { return m_toneChannels; }
+    juce::uint8 GetVelocity() const { return m_uVelocity; }
+    // Set by ChordVoiceTable::AddChord to the incoming note + channel the chord is held under, which
+    // stay the same whatever the root was quantized to
+    void SetHeldKey(int iKeyNote, int iChannel) { m_iSourceId = iChannel * SCALES_TOTAL_STEPS + iKeyNote; }
+    // Identifies this chord's notes on the scheduler, unique per held key, 0 for a chord that isn't held in a table
+    int GetSourceId() const { return m_iSourceId; }
 
 private:
-    ChordNotes m_notesPressed;
+    // A copy, the scale a diatonic chord came from can be replaced while the chord is held
+    ChordNotes m_chordNotes;
+    // Fixed at note-on, so the note-off ends the same notes whatever the voicer does in between
+    VoicedChord m_voicedChord;
+    StrummedNotes m_strummedNotes;
+    juce::uint8 m_toneChannels[CHORD_MAX_NOTES];
+    bool m_bMpe;
+    // When the note-ons were scheduled, the note-offs never go out before them
+    juce::int64 m_iNoteOnSampleTime;
     Chords::Type::eType m_eChordType;
     int m_iRootNote;
     double m_dTimeStamp;
     juce::uint8 m_uVelocity;
     int m_iChannel;
+    int m_iSourceId;
 };
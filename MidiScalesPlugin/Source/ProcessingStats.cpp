@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+    ProcessingStats.cpp
+    Created: 17 Oct 2026 4:40:39pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ProcessingStats.h"
+
+juce::String ProcessingStats::Summary::ToString() const
+{
+    if(iNumBlocks == 0)
+        return "No blocks processed";
+    
+    return juce::String::formatted("%d blocks | avg %.1f us, p50 %.1f us, p99 %.1f us, min %.1f us, max %.1f us of %.0f us (%.2f%% avg, %.2f%% max) | in %.1f, out %.1f events/block, %.1f chord notes/block, fan-out %.2fx",
+                                   iNumBlocks, dAvgMicros, dP50Micros, dP99Micros, dMinMicros, dMaxMicros, dDeadlineMicros,
+                                   100.0 * dAvgLoad, 100.0 * dMaxLoad,
+                                   dAvgInputEvents, dAvgOutputEvents, dAvgChordNotes, dFanOut)
+         + (iDroppedBlocks > 0 ? juce::String(" | ") + juce::String(iDroppedBlocks) + " dropped" : juce::String());
+}
+
+ProcessingStats::ProcessingStats()
+{
+    m_bAttached.set(0);
+    m_iDroppedBlocks.set(0);
+    m_dSampleRate.set(0.0);
+    m_uPrepareCount.set(0);
+    m_uHistoryPrepareCount = 0;
+    ClearHistory();
+}
+
+ProcessingStats::~ProcessingStats()
+{
+}
+
+void ProcessingStats::Prepare(double dSampleRate)
+{
+    m_dSampleRate.set(dSampleRate);
+    m_uPrepareCount += 1;
+}
+
+void ProcessingStats::Attach()
+{
+    // Only the reader may move the read position, so drop leftovers by reading them
+    m_fifo.finishedRead(m_fifo.getNumReady());
+    ClearHistory();
+    
+    m_bAttached.set(1);
+}
+
+void ProcessingStats::Detach()
+{
+    m_bAttached.set(0);
+}
+
+void ProcessingStats::ClearHistory()
+{
+    m_iHistoryWritePos = 0;
+    m_iHistorySize = 0;
+    m_iDroppedBlocksBefore = m_iDroppedBlocks.get();
+}
+
+void ProcessingStats::Push(const Block& block) noexcept
+{
+    if(m_bAttached.get() == 0)
+        return;
+    
+    int iStart1, iSize1, iStart2, iSize2;
+    m_fifo.prepareToWrite(1, iStart1, iSize1, iStart2, iSize2);
+    
+    if(iSize1 + iSize2 < 1)
+    {
+        m_iDroppedBlocks += 1;
+        return;
+    }
+    
+    PreparedBlock& preparedBlock = m_fifoBlocks[iSize1 > 0 ? iStart1 : iStart2];
+    preparedBlock.block = block;
+    preparedBlock.dSampleRate = m_dSampleRate.get();
+    preparedBlock.uPrepareCount = m_uPrepareCount.get();
+    m_fifo.finishedWrite(1);
+}
+
+ProcessingStats::Summary ProcessingStats::Update()
+{
+    int iStart1, iSize1, iStart2, iSize2;
+    m_fifo.prepareToRead(m_fifo.getNumReady(), iStart1, iSize1, iStart2, iSize2);
+    
+    auto addToHistory = [this](int iStart, int iSize)
+    {
+        for(int i = iStart; i < iStart + iSize; i++)
+        {
+            // The first block after a Prepare() starts over, the old sample rate's blocks aren't comparable
+            if(m_fifoBlocks[i].uPrepareCount != m_uHistoryPrepareCount)
+            {
+                m_uHistoryPrepareCount = m_fifoBlocks[i].uPrepareCount;
+                ClearHistory();
+            }
+            
+            m_history[m_iHistoryWritePos] = m_fifoBlocks[i];
+            m_iHistoryWritePos = (m_iHistoryWritePos + 1) % PROCESSING_STATS_HISTORY_SIZE;
+            m_iHistorySize = juce::jmin(m_iHistorySize + 1, PROCESSING_STATS_HISTORY_SIZE);
+        }
+    };
+    
+    addToHistory(iStart1, iSize1);
+    addToHistory(iStart2, iSize2);
+    m_fifo.finishedRead(iSize1 + iSize2);
+    
+    Summary summary;
+    summary.iNumBlocks = m_iHistorySize;
+    summary.iDroppedBlocks = m_iDroppedBlocks.get() - m_iDroppedBlocksBefore;
+    
+    if(m_iHistorySize == 0)
+        return summary;
+    
+    const double dMicrosPerTick = 1.0e6 / (double) juce::Time::getHighResolutionTicksPerSecond();
+    double dTotalMicros = 0.0, dTotalDeadlineMicros = 0.0, dTotalLoad = 0.0, dMaxLoad = 0.0;
+    juce::int64 iTotalInputEvents = 0, iTotalOutputEvents = 0, iTotalChordNotes = 0;
+    
+    for(int i=0; i<m_iHistorySize; i++)
+    {
+        const Block& block = m_history[i].block;
+        m_sortedMicros[i] = (double) block.iTicks * dMicrosPerTick;
+        dTotalMicros += m_sortedMicros[i];
+        
+        // Each block against the time its own samples last, hosts vary the block size
+        const double dDeadlineMicros = m_history[i].dSampleRate > 0.0 ? block.iNumSamples * 1.0e6 / m_history[i].dSampleRate : 0.0;
+        const double dLoad = dDeadlineMicros > 0.0 ? m_sortedMicros[i] / dDeadlineMicros : 0.0;
+        dTotalDeadlineMicros += dDeadlineMicros;
+        dTotalLoad += dLoad;
+        dMaxLoad = juce::jmax(dMaxLoad, dLoad);
+        
+        iTotalInputEvents += block.iInputEvents;
+        iTotalOutputEvents += block.iOutputEvents;
+        iTotalChordNotes += block.iChordNotes;
+    }
+    
+    std::sort(m_sortedMicros, m_sortedMicros + m_iHistorySize);
+    
+    auto percentile = [this](double dFraction)
+    {
+        const int iIndex = juce::jlimit(0, m_iHistorySize - 1, (int) std::ceil(dFraction * m_iHistorySize) - 1);
+        return m_sortedMicros[iIndex];
+    };
+    
+    summary.dMinMicros = m_sortedMicros[0];
+    summary.dMaxMicros = m_sortedMicros[m_iHistorySize - 1];
+    summary.dAvgMicros = dTotalMicros / m_iHistorySize;
+    summary.dDeadlineMicros = dTotalDeadlineMicros / m_iHistorySize;
+    summary.dAvgLoad = dTotalLoad / m_iHistorySize;
+    summary.dMaxLoad = dMaxLoad;
+    summary.dP50Micros = percentile(0.5);
+    summary.dP99Micros = percentile(0.99);
+    summary.dAvgInputEvents = (double) iTotalInputEvents / m_iHistorySize;
+    summary.dAvgOutputEvents = (double) iTotalOutputEvents / m_iHistorySize;
+    summary.dAvgChordNotes = (double) iTotalChordNotes / m_iHistorySize;
+    summary.dFanOut = iTotalInputEvents > 0 ? (double) iTotalOutputEvents / (double) iTotalInputEvents : 0.0;
+    
+    return summary;
+}
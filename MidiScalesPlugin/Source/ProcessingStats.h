@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    ProcessingStats.h
+    Created: 17 Oct 2026 4:40:17pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities.h"
+
+// Per-block processing cost of the audio thread. processBlock pushes one Block per
+// callback into a lock-free single producer/single consumer FIFO. A single reader
+// (the editor's timer or a headless dump) attaches, drains it and summarises the most
+// recent blocks, each against the time its own number of samples lasts at the prepared
+// sample rate. Nothing is collected while no reader is attached.
+class ProcessingStats
+{
+public:
+    struct Block
+    {
+        juce::int64 iTicks;         // Wall time spent in processBlock, in high resolution ticks
+        int iNumSamples;
+        int iInputEvents;
+        int iOutputEvents;
+        int iChordNotes;            // Chord tones started by this block's note-ons
+    };
+    
+    struct Summary
+    {
+        int iNumBlocks = 0;
+        juce::int64 iDroppedBlocks = 0;     // Blocks the attached reader wasn't fast enough to collect
+        double dDeadlineMicros = 0.0;       // Time available per block, on average over the blocks
+        double dMinMicros = 0.0;
+        double dAvgMicros = 0.0;
+        double dP50Micros = 0.0;
+        double dP99Micros = 0.0;
+        double dMaxMicros = 0.0;
+        double dAvgInputEvents = 0.0;
+        double dAvgOutputEvents = 0.0;
+        double dAvgChordNotes = 0.0;
+        double dFanOut = 0.0;               // Output events per input event
+        // Share of its own deadline each block used, on average and in the worst block
+        double dAvgLoad = 0.0;
+        double dMaxLoad = 0.0;
+        
+        juce::String ToString() const;
+    };
+    
+    ProcessingStats();
+    ~ProcessingStats();
+    
+    // Blocks pushed from here on start a new history, the reader drops the previous one
+    void Prepare(double dSampleRate);
+    
+    // Reader thread only. Stale blocks and drops from a previous reader are forgotten.
+    void Attach();
+    void Detach();
+    
+    // Audio thread only. Wait free, drops the block if the FIFO is full, does nothing while no reader is attached.
+    void Push(const Block& block) noexcept;
+    
+    // Reader thread only. Drains the FIFO into the history and summarises it.
+    Summary Update();
+    
+private:
+    // A pushed block and the Prepare() it was processed after
+    struct PreparedBlock
+    {
+        Block block;
+        double dSampleRate;
+        juce::uint32 uPrepareCount;
+    };
+    
+    void ClearHistory();
+    
+    juce::AbstractFifo m_fifo { PROCESSING_STATS_FIFO_SIZE };
+    PreparedBlock m_fifoBlocks[PROCESSING_STATS_FIFO_SIZE];
+    juce::Atomic<int> m_bAttached;
+    juce::Atomic<int> m_iDroppedBlocks;
+    juce::Atomic<double> m_dSampleRate;
+    juce::Atomic<juce::uint32> m_uPrepareCount;
+    
+    // Reader side
+    PreparedBlock m_history[PROCESSING_STATS_HISTORY_SIZE];
+    double m_sortedMicros[PROCESSING_STATS_HISTORY_SIZE];
+    int m_iHistoryWritePos;
+    int m_iHistorySize;
+    juce::uint32 m_uHistoryPrepareCount;
+    // Drops counted before the reader attached or the history started over
+    int m_iDroppedBlocksBefore;
+    
+    JUCE_DECLARE_NON_COPYABLE (ProcessingStats)
+};
@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    RealtimeAllocations.cpp
+    Created: 17 Oct 2026 10:12:21am
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "RealtimeAllocations.h"
+
+#if MIDISCALES_CHECK_REALTIME_ALLOCATIONS
+
+#include <cstdlib>
+#include <new>
+
+namespace RealtimeAllocations
+{
+    static thread_local int s_iRegionDepth = 0;
+    static std::atomic<juce::int64> s_allocationCount { 0 };
+    static std::atomic<bool> s_bAssertOnAllocation { true };
+    
+    ScopedNoAllocationRegion::ScopedNoAllocationRegion()
+    {
+        ++s_iRegionDepth;
+    }
+    
+    ScopedNoAllocationRegion::~ScopedNoAllocationRegion()
+    {
+        --s_iRegionDepth;
+    }
+    
+    juce::int64 GetAllocationCount()
+    {
+        return s_allocationCount.load();
+    }
+    
+    void SetAssertOnAllocation(bool bShouldAssert)
+    {
+        s_bAssertOnAllocation.store(bShouldAssert);
+    }
+    
+    void ReportAllocation()
+    {
+        ++s_allocationCount;
+        
+        // Leave the region while asserting, the assertion logging allocates itself
+        const int iPreviousDepth = s_iRegionDepth;
+        s_iRegionDepth = 0;
+        
+        // If you hit this, something on the audio thread allocated. Check the call stack!
+        jassert(! s_bAssertOnAllocation.load());
+        
+        s_iRegionDepth = iPreviousDepth;
+    }
+    
+    static void OnAllocation()
+    {
+        if(s_iRegionDepth > 0)
+            ReportAllocation();
+    }
+    
+    static void* Allocate(std::size_t size)
+    {
+        OnAllocation();
+        
+        if(void* pMemory = std::malloc(size == 0 ? 1 : size))
+            return pMemory;
+        
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new (std::size_t size)                                   { return RealtimeAllocations::Allocate(size); }
+void* operator new[] (std::size_t size)                                 { return RealtimeAllocations::Allocate(size); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept   { RealtimeAllocations::OnAllocation(); return std::malloc(size == 0 ? 1 : size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept { RealtimeAllocations::OnAllocation(); return std::malloc(size == 0 ? 1 : size); }
+void operator delete (void* pMemory) noexcept                           { std::free(pMemory); }
+void operator delete[] (void* pMemory) noexcept                         { std::free(pMemory); }
+void operator delete (void* pMemory, std::size_t) noexcept              { std::free(pMemory); }
+void operator delete[] (void* pMemory, std::size_t) noexcept            { std::free(pMemory); }
+
+#else
+
+namespace RealtimeAllocations
+{
+    void ReportAllocation()                     {}
+    juce::int64 GetAllocationCount()            { return 0; }
+    void SetAssertOnAllocation(bool)            {}
+}
+
+#endif
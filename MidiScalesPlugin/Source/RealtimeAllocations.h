@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    RealtimeAllocations.h
+    Created: 17 Oct 2026 10:12:04am
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// When enabled, the global allocation functions are replaced so that any heap
+// allocation made inside a ScopedNoAllocationRegion is counted and asserted on.
+// JUCE containers grow through malloc/realloc rather than operator new, so those
+// are covered separately with ScopedStorageCheck.
+// Off unless the build defines it: only the command line target does, replacing the
+// global operator new inside a plugin would hook every allocation of the host process.
+#ifndef MIDISCALES_CHECK_REALTIME_ALLOCATIONS
+ #define MIDISCALES_CHECK_REALTIME_ALLOCATIONS 0
+#endif
+
+namespace RealtimeAllocations
+{
+    // Marks the current thread as being inside code that must not touch the heap (e.g. processBlock)
+    class ScopedNoAllocationRegion
+    {
+    public:
+       #if MIDISCALES_CHECK_REALTIME_ALLOCATIONS
+        ScopedNoAllocationRegion();
+        ~ScopedNoAllocationRegion();
+       #else
+        ScopedNoAllocationRegion() {}
+       #endif
+        
+    private:
+        JUCE_DECLARE_NON_COPYABLE (ScopedNoAllocationRegion)
+    };
+    
+    // Counts (and by default asserts on) an allocation made inside a no-allocation region
+    void ReportAllocation();
+    
+    // Flags an allocation if the storage of a JUCE container (e.g. MidiBuffer::data)
+    // has moved by the time this goes out of scope
+    template <typename ContainerType>
+    class ScopedStorageCheck
+    {
+    public:
+       #if MIDISCALES_CHECK_REALTIME_ALLOCATIONS
+        explicit ScopedStorageCheck(const ContainerType& container)
+        : m_container(container), m_pStorage(container.begin())
+        {
+        }
+        
+        ~ScopedStorageCheck()
+        {
+            if(m_container.begin() != m_pStorage)
+                ReportAllocation();
+        }
+        
+    private:
+        const ContainerType& m_container;
+        const void* m_pStorage;
+       #else
+        explicit ScopedStorageCheck(const ContainerType&) {}
+        
+    private:
+       #endif
+        JUCE_DECLARE_NON_COPYABLE (ScopedStorageCheck)
+    };
+    
+    // Total number of allocations seen inside no-allocation regions, on any thread.
+    // Always 0 when MIDISCALES_CHECK_REALTIME_ALLOCATIONS is disabled.
+    juce::int64 GetAllocationCount();
+    
+    // Set to false to only count allocations without asserting on them
+    void SetAssertOnAllocation(bool bShouldAssert);
+}
@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    ScaleLibrary.cpp
+    Created: 17 Oct 2026 6:10:32pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ScaleLibrary.h"
+
+// Built-in scales in integer notation, indexed by Scales::Type. Used until a library is loaded.
+static constexpr ScaleNotes s_builtInScales[Scales::Type::Total + 1] =
+{
+    MakeIntervalSet<SCALES_OCTAVE_STEPS>({}),                           // Invalid
+    MakeIntervalSet<SCALES_OCTAVE_STEPS>({0, 2, 4, 5, 7, 9, 11}),       // Major
+    MakeIntervalSet<SCALES_OCTAVE_STEPS>({0, 2, 3, 5, 7, 8, 10}),       // NaturalMinor
+    MakeIntervalSet<SCALES_OCTAVE_STEPS>({0, 2, 3, 5, 7, 8, 11}),       // HarmonicMinor
+    MakeIntervalSet<SCALES_OCTAVE_STEPS>({0, 2, 3, 5, 7, 9, 11})        // MelodicMinor
+};
+
+static const char* s_builtInScaleNames[Scales::Type::Total + 1] =
+{
+    "Invalid", "Major/Ionian", "Natural Minor", "Harmonic Minor", "Melodic Minor"
+};
+
+// Built-in chords in integer notation, indexed by Chords::Type
+static constexpr ChordNotes s_builtInChords[Chords::Type::Total + 1] =
+{
+    MakeIntervalSet<CHORD_MAX_NOTES>({}),                               // Invalid
+    MakeIntervalSet<CHORD_MAX_NOTES>({0, 4, 7}),                        // MajorTriad
+    MakeIntervalSet<CHORD_MAX_NOTES>({0, 3, 7}),                        // MinorTriad
+    MakeIntervalSet<CHORD_MAX_NOTES>({0, 4, 7, 11}),                    // MajorSeventh
+    MakeIntervalSet<CHORD_MAX_NOTES>({0, 3, 7, 10})                     // MinorSeventh
+};
+
+static const char* s_builtInChordNames[Chords::Type::Total + 1] =
+{
+    "Invalid", "Major Triad", "Minor Triad", "Major Seventh", "Minor Seventh"
+};
+
+// Steps must be ascending, below iStepLimit and agree with the mask
+template <int MaxSteps>
+static bool IsValidIntervalSet(const IntervalSet<MaxSteps>& intervalSet, int iStepLimit)
+{
+    if(intervalSet.numSteps < 0 || intervalSet.numSteps > MaxSteps)
+        return false;
+    
+    juce::uint32 uMask = 0;
+    for(int i=0; i<intervalSet.numSteps; i++)
+    {
+        const int iStep = intervalSet.steps[i];
+        if(iStep >= iStepLimit || (i > 0 && iStep <= intervalSet.steps[i-1]))
+            return false;
+        
+        uMask |= 1u << iStep;
+    }
+    
+    return uMask == intervalSet.mask;
+}
+
+static bool IsSectionInside(const ScaleLibraryFormat::Header& header, juce::uint32 uOffset, juce::uint32 uCount, size_t uElementBytes)
+{
+    return uOffset % SCALE_LIBRARY_ALIGNMENT == 0
+        && (juce::uint64) uOffset + (juce::uint64) uCount * uElementBytes <= header.uTotalBytes;
+}
+
+ScaleLibrary::ScaleLibrary()
+{
+    UseBuiltInTables();
+}
+
+ScaleLibrary::ScaleLibrary(const juce::File& libraryFile)
+{
+    UseBuiltInTables();
+    LoadFile(libraryFile);
+}
+
+ScaleLibrary::~ScaleLibrary()
+{
+}
+
+void ScaleLibrary::UseBuiltInTables()
+{
+    m_pMappedFile.reset();
+    
+    m_pScales = s_builtInScales;
+    m_pChords = s_builtInChords;
+    m_iNumScales = Scales::Type::Total + 1;
+    m_iNumChords = Chords::Type::Total + 1;
+    
+    m_pScaleNameOffsets = nullptr;
+    m_pChordNameOffsets = nullptr;
+    m_pStrings = nullptr;
+}
+
+bool ScaleLibrary::LoadFile(const juce::File& libraryFile)
+{
+    if(!libraryFile.existsAsFile())
+        return false;
+    
+    std::unique_ptr<juce::MemoryMappedFile> pMappedFile = std::make_unique<juce::MemoryMappedFile>(libraryFile, juce::MemoryMappedFile::readOnly);
+    const juce::uint8* pData = static_cast<const juce::uint8*> (pMappedFile->getData());
+    
+    // Validating touches every record, so the audio thread doesn't fault those pages in later
+    if(pData == nullptr || !IsValidLibrary(pData, pMappedFile->getSize()))
+        return false;
+    
+    const ScaleLibraryFormat::Header& header = *reinterpret_cast<const ScaleLibraryFormat::Header*> (pData);
+    
+    m_pScales = reinterpret_cast<const ScaleNotes*> (pData + header.uScalesOffset);
+    m_pChords = reinterpret_cast<const ChordNotes*> (pData + header.uChordsOffset);
+    m_iNumScales = (int) header.uNumScales;
+    m_iNumChords = (int) header.uNumChords;
+    
+    m_pScaleNameOffsets = reinterpret_cast<const juce::uint32*> (pData + header.uScaleNamesOffset);
+    m_pChordNameOffsets = reinterpret_cast<const juce::uint32*> (pData + header.uChordNamesOffset);
+    m_pStrings = reinterpret_cast<const char*> (pData + header.uStringsOffset);
+    
+    m_pMappedFile = std::move(pMappedFile);
+    return true;
+}
+
+bool ScaleLibrary::IsValidLibrary(const void* pData, size_t uBytes)
+{
+    using namespace ScaleLibraryFormat;
+    
+    if(pData == nullptr || uBytes < sizeof(Header) || (reinterpret_cast<juce::pointer_sized_uint> (pData) % SCALE_LIBRARY_ALIGNMENT) != 0)
+        return false;
+    
+    const juce::uint8* pBytes = static_cast<const juce::uint8*> (pData);
+    const Header& header = *reinterpret_cast<const Header*> (pBytes);
+    
+    if(header.uMagic != SCALE_LIBRARY_MAGIC || header.uVersion != SCALE_LIBRARY_VERSION || header.uTotalBytes > uBytes)
+        return false;
+    
+    // Written by a build with a different CHORD_MAX_NOTES or record layout
+    if(header.uScaleRecordBytes != sizeof(ScaleNotes) || header.uChordRecordBytes != sizeof(ChordNotes))
+        return false;
+    
+    // IDs have to fit the Scales::Type/Chords::Type ints and entry 0 is always Invalid
+    if(header.uNumScales < 1 || header.uNumChords < 1 || header.uNumScales > 0xffff || header.uNumChords > 0xffff)
+        return false;
+    
+    if(!IsSectionInside(header, header.uScalesOffset, header.uNumScales, sizeof(ScaleNotes))
+       || !IsSectionInside(header, header.uChordsOffset, header.uNumChords, sizeof(ChordNotes))
+       || !IsSectionInside(header, header.uScaleNamesOffset, header.uNumScales, sizeof(juce::uint32))
+       || !IsSectionInside(header, header.uChordNamesOffset, header.uNumChords, sizeof(juce::uint32))
+       || !IsSectionInside(header, header.uStringsOffset, header.uStringsBytes, 1)
+       || header.uStringsBytes == 0)
+        return false;
+    
+    // Every name must end inside the string block
+    const char* pStrings = reinterpret_cast<const char*> (pBytes + header.uStringsOffset);
+    if(pStrings[header.uStringsBytes - 1] != 0)
+        return false;
+    
+    const ScaleNotes* pScales = reinterpret_cast<const ScaleNotes*> (pBytes + header.uScalesOffset);
+    const juce::uint32* pScaleNameOffsets = reinterpret_cast<const juce::uint32*> (pBytes + header.uScaleNamesOffset);
+    for(juce::uint32 i=0; i<header.uNumScales; i++)
+    {
+        if(!IsValidIntervalSet(pScales[i], SCALES_OCTAVE_STEPS) || pScaleNameOffsets[i] >= header.uStringsBytes)
+            return false;
+    }
+    
+    const ChordNotes* pChords = reinterpret_cast<const ChordNotes*> (pBytes + header.uChordsOffset);
+    const juce::uint32* pChordNameOffsets = reinterpret_cast<const juce::uint32*> (pBytes + header.uChordNamesOffset);
+    for(juce::uint32 i=0; i<header.uNumChords; i++)
+    {
+        // Steps index the 32 bit interval mask
+        if(!IsValidIntervalSet(pChords[i], 32) || pChordNameOffsets[i] >= header.uStringsBytes)
+            return false;
+    }
+    
+    return pScales[0].size() == 0 && pChords[0].size() == 0;
+}
+
+const char* ScaleLibrary::GetScaleName(int iId) const
+{
+    const int iIndex = iId >= 0 && iId < m_iNumScales ? iId : 0;
+    return m_pStrings != nullptr ? m_pStrings + m_pScaleNameOffsets[iIndex] : s_builtInScaleNames[iIndex];
+}
+
+const char* ScaleLibrary::GetChordName(int iId) const
+{
+    const int iIndex = iId >= 0 && iId < m_iNumChords ? iId : 0;
+    return m_pStrings != nullptr ? m_pStrings + m_pChordNameOffsets[iIndex] : s_builtInChordNames[iIndex];
+}
+
+const ScaleLibrary& ScaleLibrary::GetInstance()
+{
+    // Constructed once, thread safe, on the first call. The processor makes that call
+    // from its constructor so the audio thread never maps the file.
+    static const ScaleLibrary s_library (ScaleLibraryFormat::GetUserLibraryFile());
+    return s_library;
+}
@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    ScaleLibrary.h
+    Created: 17 Oct 2026 6:10:14pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities.h"
+#include "ScaleLibraryFormat.h"
+
+// Scale and chord tables indexed by ID. Starts out with the built-in types and can
+// switch to a library pack compiled by MidiScalesContentEditor, which is memory mapped
+// and used in place. Lookups are O(1) array accesses and never allocate.
+class ScaleLibrary
+{
+public:
+    ScaleLibrary();
+    // Falls back to the built-in tables if the file is missing or invalid
+    explicit ScaleLibrary(const juce::File& libraryFile);
+    ~ScaleLibrary();
+    
+    // Keeps the current tables and returns false if the file isn't a valid library
+    bool LoadFile(const juce::File& libraryFile);
+    // Checks the header, bounds and every record. No text is parsed.
+    static bool IsValidLibrary(const void* pData, size_t uBytes);
+    
+    bool IsBuiltIn() const { return m_pMappedFile == nullptr; }
+    
+    // Number of IDs, including the Invalid entry at 0 and any unused IDs
+    int GetNumScales() const { return m_iNumScales; }
+    int GetNumChords() const { return m_iNumChords; }
+    
+    bool IsValidScale(int iId) const { return iId > 0 && iId < m_iNumScales && m_pScales[iId].size() > 0; }
+    bool IsValidChord(int iId) const { return iId > 0 && iId < m_iNumChords && m_pChords[iId].size() > 0; }
+    
+    // Unknown IDs return the empty Invalid entry
+    const ScaleNotes& GetScale(int iId) const { return m_pScales[IsValidScale(iId) ? iId : 0]; }
+    const ChordNotes& GetChord(int iId) const { return m_pChords[IsValidChord(iId) ? iId : 0]; }
+    const char* GetScaleName(int iId) const;
+    const char* GetChordName(int iId) const;
+    
+    // Shared by every plugin instance in the process, maps the user library on first use
+    static const ScaleLibrary& GetInstance();
+    
+private:
+    void UseBuiltInTables();
+    
+    std::unique_ptr<juce::MemoryMappedFile> m_pMappedFile;
+    
+    const ScaleNotes* m_pScales;
+    const ChordNotes* m_pChords;
+    int m_iNumScales;
+    int m_iNumChords;
+    
+    // Only set for a library pack, the built-in names are plain string tables
+    const juce::uint32* m_pScaleNameOffsets;
+    const juce::uint32* m_pChordNameOffsets;
+    const char* m_pStrings;
+    
+    JUCE_DECLARE_NON_COPYABLE (ScaleLibrary)
+};
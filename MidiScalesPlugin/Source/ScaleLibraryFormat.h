@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    ScaleLibraryFormat.h
+    Created: 17 Oct 2026 6:02:51pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities.h"
+#include <type_traits>
+
+// Packed scale/chord library, written by MidiScalesContentEditor and memory mapped
+// by the plugin. Little endian, every section starts on a 4 byte boundary:
+//
+//   Header
+//   ScaleNotes[uNumScales]     Record index is the Scales::Type ID, an empty record is an unused ID
+//   ChordNotes[uNumChords]     Record index is the Chords::Type ID
+//   uint32[uNumScales]         Offset of each scale's name in the string block
+//   uint32[uNumChords]         Offset of each chord's name in the string block
+//   char[uStringsBytes]        Null terminated UTF-8 names
+//
+// Records are the plugin's own IntervalSet layout, so the plugin uses them in place
+// and nothing is parsed when it loads.
+#define SCALE_LIBRARY_MAGIC 0x424C534D      // "MSLB"
+#define SCALE_LIBRARY_VERSION 1
+#define SCALE_LIBRARY_ALIGNMENT 4
+#define SCALE_LIBRARY_FOLDER_NAME "MidiScales"
+#define SCALE_LIBRARY_FILE_NAME "ScaleLibrary.mslib"
+
+namespace ScaleLibraryFormat
+{
+    struct Header
+    {
+        juce::uint32 uMagic;
+        juce::uint32 uVersion;
+        juce::uint32 uTotalBytes;
+        juce::uint32 uScaleRecordBytes;     // sizeof(ScaleNotes) of the writer, the reader rejects a mismatch
+        juce::uint32 uChordRecordBytes;     // sizeof(ChordNotes) of the writer, changes with CHORD_MAX_NOTES
+        juce::uint32 uNumScales;
+        juce::uint32 uScalesOffset;
+        juce::uint32 uScaleNamesOffset;
+        juce::uint32 uNumChords;
+        juce::uint32 uChordsOffset;
+        juce::uint32 uChordNamesOffset;
+        juce::uint32 uStringsOffset;
+        juce::uint32 uStringsBytes;
+    };
+    
+    static_assert(std::is_trivially_copyable<ScaleNotes>::value && std::is_standard_layout<ScaleNotes>::value,
+                  "Scale records are read in place from the library");
+    static_assert(std::is_trivially_copyable<ChordNotes>::value && std::is_standard_layout<ChordNotes>::value,
+                  "Chord records are read in place from the library");
+    static_assert(sizeof(Header) % SCALE_LIBRARY_ALIGNMENT == 0 && sizeof(ScaleNotes) % SCALE_LIBRARY_ALIGNMENT == 0,
+                  "Sections must stay aligned");
+    
+    // Where the content editor installs the library and the plugin looks for it
+    inline juce::File GetUserLibraryFile()
+    {
+        return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                   .getChildFile(SCALE_LIBRARY_FOLDER_NAME)
+                   .getChildFile(SCALE_LIBRARY_FILE_NAME);
+    }
+}
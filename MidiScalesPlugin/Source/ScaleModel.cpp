@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    ScaleModel.cpp
+    Created: 17 Oct 2026 9:27:14pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "ScaleModel.h"
+
+ScaleModel::Ptr ScaleModel::Create(int iScaleNote, Scales::Type::eType scaleType, bool bSharps)
+{
+    return new ScaleModel(iScaleNote, scaleType, bSharps);
+}
+
+ScaleModel::ScaleModel(int iScaleNote, Scales::Type::eType scaleType, bool bSharps)
+: m_iScaleNote(iScaleNote),
+m_scaleType(scaleType),
+m_bSharps(bSharps)
+{
+    m_pScaleNotes = &Helpers::GetScaleSequence(m_scaleType);
+    m_mask = Helpers::GetScaleMask(m_scaleType, m_iScaleNote);
+    
+    m_iBaseNote = -1;
+    if(m_iScaleNote >= 0)
+    {
+        const juce::String rootName = juce::MidiMessage::getMidiNoteName(m_iScaleNote, m_bSharps, false, 3);
+        m_iBaseNote = Helpers::GetNoteType(rootName.substring(0, 1).toRawUTF8());
+    }
+    
+    for(int i = 0; i < SCALES_OCTAVE_STEPS; i++)
+    {
+        m_degrees[i] = (juce::int8) (IsValid() ? m_pScaleNotes->IndexOf((i - m_iScaleNote + SCALES_OCTAVE_STEPS) % SCALES_OCTAVE_STEPS) : -1);
+        m_noteLabels[i] = CalculateNoteLabel(i);
+    }
+    
+    BuildQuantizeMaps();
+    BuildDiatonicChords();
+}
+
+juce::String ScaleModel::CalculateNoteLabel(int iPitchClass) const
+{
+    const int idx = m_degrees[iPitchClass];
+    
+    if(idx >= 0)
+    {
+        const int iShiftedMajorNote = (idx + m_iBaseNote) % Notes::Type::Total;
+        
+        juce::String majorNoteType(Helpers::GetNoteString((Notes::Type::eType) iShiftedMajorNote));
+        
+        const int iMajorNoteNumber = Helpers::GetNoteNumber((Notes::Type::eType) iShiftedMajorNote);
+        int iNoteDiff =  iPitchClass - iMajorNoteNumber;
+        if(abs(iNoteDiff) > 5)
+            iNoteDiff = iNoteDiff > 0 ? iNoteDiff - SCALES_OCTAVE_STEPS : iNoteDiff + SCALES_OCTAVE_STEPS;
+        
+        juce::String noteDiff;
+        if(iNoteDiff == 1)
+            noteDiff = "#";
+        else if(iNoteDiff > 1)
+            noteDiff = "##";
+        else if(iNoteDiff == -1)
+            noteDiff = "b";
+        else if(iNoteDiff < -1)
+            noteDiff = "bb";
+        else
+            noteDiff ="";
+        
+        return majorNoteType + noteDiff;
+    }
+    
+    return "";
+}
+
+void ScaleModel::BuildQuantizeMaps()
+{
+    std::memset(m_quantizeMaps, -1, sizeof(m_quantizeMaps));
+    
+    if(!IsValid() || m_mask == 0)
+        return;
+    
+    for(int iNote = 0; iNote < SCALES_TOTAL_STEPS; iNote++)
+    {
+        const int iUp = FindScaleNote(iNote, 1);
+        const int iDown = FindScaleNote(iNote, -1);
+        
+        m_quantizeMaps[Quantize::Mode::Off][iNote] = (juce::int8) (Contains(iNote) ? iNote : -1);
+        m_quantizeMaps[Quantize::Mode::Up][iNote] = (juce::int8) (iUp >= 0 ? iUp : iDown);
+        m_quantizeMaps[Quantize::Mode::Down][iNote] = (juce::int8) (iDown >= 0 ? iDown : iUp);
+        
+        if(iUp < 0 || (iDown >= 0 && iNote - iDown <= iUp - iNote))
+            m_quantizeMaps[Quantize::Mode::Nearest][iNote] = (juce::int8) iDown;
+        else
+            m_quantizeMaps[Quantize::Mode::Nearest][iNote] = (juce::int8) iUp;
+        
+        m_quantizeMaps[Quantize::Mode::Degree][iNote] = (juce::int8) GetDegreeNote(iNote);
+    }
+}
+
+int ScaleModel::FindScaleNote(int iMidiNote, int iDirection) const
+{
+    for(int iNote = iMidiNote; iNote >= 0 && iNote < SCALES_TOTAL_STEPS; iNote += iDirection)
+    {
+        if(Contains(iNote))
+            return iNote;
+    }
+    
+    return -1;
+}
+
+int ScaleModel::GetDegreeNote(int iMidiNote) const
+{
+    // White key index within the octave, black keys take the white key below
+    const static int s_whiteKeyIndex[] = {0, 0, 1, 1, 2, 3, 3, 4, 4, 5, 5, 6};
+    const int iMiddleC = 60;
+    
+    const int iWhiteKey = (iMidiNote / SCALES_OCTAVE_STEPS) * Notes::Type::Total + s_whiteKeyIndex[iMidiNote % SCALES_OCTAVE_STEPS]
+                        - (iMiddleC / SCALES_OCTAVE_STEPS) * Notes::Type::Total;
+    
+    // Floored division so the keys below middle C walk down the scale
+    const int iNumDegrees = m_pScaleNotes->size();
+    const int iOctave = (iWhiteKey >= 0 ? iWhiteKey : iWhiteKey - iNumDegrees + 1) / iNumDegrees;
+    const int iDegree = iWhiteKey - iOctave * iNumDegrees;
+    
+    int iNote = iMiddleC + m_iScaleNote + (*m_pScaleNotes)[iDegree] + iOctave * SCALES_OCTAVE_STEPS;
+    
+    // Scales with few degrees run off the keyboard quicker than the white keys do, fold them back in
+    while(iNote >= SCALES_TOTAL_STEPS)
+        iNote -= SCALES_OCTAVE_STEPS;
+    while(iNote < 0)
+        iNote += SCALES_OCTAVE_STEPS;
+    
+    return iNote;
+}
+
+void ScaleModel::BuildDiatonicChords()
+{
+    std::memset(m_diatonicChords, 0, sizeof(m_diatonicChords));
+    std::memset(m_diatonicInversions, 0, sizeof(m_diatonicInversions));
+    
+    if(!IsValid())
+        return;
+    
+    const ScaleNotes& scaleNotes = *m_pScaleNotes;
+    const int iNumDegrees = scaleNotes.size();
+    
+    for(int iDegree = 0; iDegree < iNumDegrees; iDegree++)
+    {
+        const int iPitchClass = (m_iScaleNote + scaleNotes[iDegree]) % SCALES_OCTAVE_STEPS;
+        
+        for(int iNumNotes = 1; iNumNotes <= CHORD_MAX_NOTES; iNumNotes++)
+        {
+            ChordNotes& chordNotes = m_diatonicChords[iPitchClass][iNumNotes - 1];
+            
+            for(int i = 0; i < iNumNotes; i++)
+            {
+                // Degrees past the top of the scale continue in the next octave
+                const int iStackedDegree = iDegree + 2 * i;
+                const int iStep = scaleNotes[iStackedDegree % iNumDegrees] + SCALES_OCTAVE_STEPS * (iStackedDegree / iNumDegrees) - scaleNotes[iDegree];
+                
+                // Scales with few degrees climb faster than the interval mask can hold
+                if(iStep >= 32)
+                    break;
+                
+                chordNotes.mask |= 1u << iStep;
+                chordNotes.steps[chordNotes.numSteps++] = (juce::uint8) iStep;
+            }
+            
+            ChordVoicer::BuildInversions(chordNotes, m_diatonicInversions[iPitchClass][iNumNotes - 1]);
+        }
+    }
+}
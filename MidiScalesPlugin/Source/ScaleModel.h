@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ScaleModel.h
+    Created: 17 Oct 2026 9:26:51pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "Utilities.h"
+#include "ChordVoicer.h"
+
+// Immutable snapshot of the selected scale: its pitch classes, the scale degree of each
+// and how each is spelled. Built once per scale change on the message thread and shared
+// read-only by the processor (audio thread included) and the keyboard component.
+class ScaleModel : public juce::ReferenceCountedObject
+{
+public:
+    typedef juce::ReferenceCountedObjectPtr<ScaleModel> Ptr;
+    
+    // bSharps picks the letter of a black key root (C# or Db), the other notes are spelled from it
+    static Ptr Create(int iScaleNote, Scales::Type::eType scaleType, bool bSharps);
+    
+    int GetScaleNote() const { return m_iScaleNote; }
+    Scales::Type::eType GetScaleType() const { return m_scaleType; }
+    bool UsesSharps() const { return m_bSharps; }
+    bool IsValid() const { return m_iScaleNote >= 0 && m_iBaseNote >= 0 && m_pScaleNotes->size() > 0; }
+    
+    const ScaleNotes& GetScaleNotes() const { return *m_pScaleNotes; }
+    ScaleMask GetMask() const { return m_mask; }
+    
+    bool Contains(int iMidiNote) const { return (m_mask >> (iMidiNote % SCALES_OCTAVE_STEPS)) & 1; }
+    // Scale degree of the note (0 = root), -1 if it isn't in the scale
+    int GetDegree(int iMidiNote) const { return m_degrees[iMidiNote % SCALES_OCTAVE_STEPS]; }
+    // Note name within the scale (e.g. "F#" in D Major, "Gb" in Db Major), empty if it isn't in the scale
+    const juce::String& GetNoteLabel(int iMidiNote) const { return m_noteLabels[iMidiNote % SCALES_OCTAVE_STEPS]; }
+    
+    // Note to play for an incoming note (0-127) in this quantize mode, -1 if it isn't played
+    int GetQuantizedNote(Quantize::Mode::eMode quantizeMode, int iMidiNote) const { return m_quantizeMaps[quantizeMode][iMidiNote]; }
+    
+    // iNumNotes scale degrees stacked in thirds (every other degree) on the note, empty if the
+    // note isn't in the scale. Intervals are relative to the note like any other ChordNotes.
+    const ChordNotes& GetDiatonicChord(int iMidiNote, int iNumNotes) const
+    {
+        return m_diatonicChords[iMidiNote % SCALES_OCTAVE_STEPS][juce::jlimit(1, CHORD_MAX_NOTES, iNumNotes) - 1];
+    }
+    // The same chord's inversions, for the ChordVoicer
+    const ChordInversions& GetDiatonicInversions(int iMidiNote, int iNumNotes) const
+    {
+        return m_diatonicInversions[iMidiNote % SCALES_OCTAVE_STEPS][juce::jlimit(1, CHORD_MAX_NOTES, iNumNotes) - 1];
+    }
+    
+private:
+    ScaleModel(int iScaleNote, Scales::Type::eType scaleType, bool bSharps);
+    
+    juce::String CalculateNoteLabel(int iPitchClass) const;
+    void BuildQuantizeMaps();
+    void BuildDiatonicChords();
+    int FindScaleNote(int iMidiNote, int iDirection) const;
+    int GetDegreeNote(int iMidiNote) const;
+    
+    const int m_iScaleNote;
+    const Scales::Type::eType m_scaleType;
+    const bool m_bSharps;
+    const ScaleNotes* m_pScaleNotes;
+    int m_iBaseNote;                // Notes::Type letter of the root
+    ScaleMask m_mask;
+    juce::int8 m_degrees[SCALES_OCTAVE_STEPS];
+    juce::String m_noteLabels[SCALES_OCTAVE_STEPS];
+    juce::int8 m_quantizeMaps[Quantize::Mode::Total][SCALES_TOTAL_STEPS];
+    ChordNotes m_diatonicChords[SCALES_OCTAVE_STEPS][CHORD_MAX_NOTES];
+    ChordInversions m_diatonicInversions[SCALES_OCTAVE_STEPS][CHORD_MAX_NOTES];
+    
+    JUCE_DECLARE_NON_COPYABLE (ScaleModel)
+};
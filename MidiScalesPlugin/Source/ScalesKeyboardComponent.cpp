@@ -15,48 +15,12 @@ ScalesKeyboardComponent::ScalesKeyboardComponent (juce::MidiKeyboardState& state
 : BaseKeyboardComponent(state, orientation),
 m_keyboardState(state)
 {
-    m_iScaleRootNote = -1;
-    m_iScaleBaseNote = -1;
-    m_eScaleType = Scales::Type::Invalid;
-    
-    m_ScaleNotes.ensureStorageAllocated(SCALES_OCTAVE_STEPS);
+    m_fKeyImageScale = 1.0f;
 }
 
 juce::String ScalesKeyboardComponent::getWhiteNoteText (int midiNoteNumber)
 {
-    if(!HasValidScale())
-        return "";
-    
-    const int iNoteNumber = midiNoteNumber % SCALES_OCTAVE_STEPS;
-    const int idx = m_ScaleNotes.indexOf(iNoteNumber);
-    
-    if(idx >= 0)
-    {
-        const int iShiftedMajorNote = (idx + m_iScaleBaseNote) % Notes::Type::Total;
-        
-        juce::String majorNoteType(Helpers::GetNoteString((Notes::Type::eType) iShiftedMajorNote));
-        
-        const int iMajorNoteNumber = Helpers::GetNoteNumber((Notes::Type::eType) iShiftedMajorNote);
-        int iNoteDiff =  iNoteNumber - iMajorNoteNumber;
-        if(abs(iNoteDiff) > 5)
-            iNoteDiff = iNoteDiff > 0 ? iNoteDiff - SCALES_OCTAVE_STEPS : iNoteDiff + SCALES_OCTAVE_STEPS;
-        
-        juce::String noteDiff;
-        if(iNoteDiff == 1)
-            noteDiff = "#";
-        else if(iNoteDiff > 1)
-            noteDiff = "##";
-        else if(iNoteDiff == -1)
-            noteDiff = "b";
-        else if(iNoteDiff < -1)
-            noteDiff = "bb";
-        else
-            noteDiff ="";
-        
-        return majorNoteType + noteDiff;
-    }
- 
-    return "";
+    return HasValidScale() ? m_pScaleModel->GetNoteLabel(midiNoteNumber) : juce::String();
 }
 
 juce::String ScalesKeyboardComponent::getBlackNoteText (int midiNoteNumber)
@@ -68,6 +32,28 @@ juce::String ScalesKeyboardComponent::getBlackNoteText (int midiNoteNumber)
 void ScalesKeyboardComponent::drawBlackNote (int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area,
                                              bool isDown, bool isOver, juce::Colour noteFillColour)
 {
+    UpdateKeyImageScale(g);
+    
+    const eKeyImage keyImage = GetKeyImageType(midiNoteNumber, isDown);
+    // One pixel of margin for the separator line drawn past the last key
+    const juce::Rectangle<int> imageArea = area.expanded(1.0f).getSmallestIntegerContainer();
+    juce::Image& image = m_keyImages[midiNoteNumber][keyImage];
+    
+    if(image.isNull())
+    {
+        image = CreateKeyImage(imageArea);
+        juce::Graphics imageGraphics(image);
+        imageGraphics.addTransform(GetKeyImageTransform(imageArea));
+        RenderBlackNote(midiNoteNumber, imageGraphics, area, keyImage, noteFillColour);
+    }
+    
+    g.setOpacity(1.0f);
+    g.drawImage(image, imageArea.toFloat());
+}
+
+void ScalesKeyboardComponent::RenderBlackNote(int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area, eKeyImage keyImage, juce::Colour noteFillColour)
+{
+    const bool isDown = keyImage != KeyImageUp;
     auto c = noteFillColour;
     
     juce::Colour pressedColour = juce::Colours::lightblue;
@@ -76,8 +62,8 @@ void ScalesKeyboardComponent::drawBlackNote (int midiNoteNumber, juce::Graphics&
 
     if (isDown)
     {
-        const bool bNoteActive = m_keyboardState.isNoteOn(KEYBOARD_UI_NOTE_CHANNEL, midiNoteNumber);
-        if(bNoteActive && !m_ScaleNotes.contains(midiNoteNumber % SCALES_OCTAVE_STEPS))
+        const bool bNoteActive = keyImage == KeyImageDownRoot;
+        if(bNoteActive && !IsNoteInScale(midiNoteNumber))
         {
             c = c.overlaidWith ( invalidColour );
         }
@@ -121,7 +107,7 @@ void ScalesKeyboardComponent::drawBlackNote (int midiNoteNumber, juce::Graphics&
         auto fontHeight = juce::jmin (16.0f, getKeyWidth() * 0.9f);
         
 
-        const bool bRootNoteOn = isDown ? m_keyboardState.isNoteOn(KEYBOARD_UI_NOTE_CHANNEL, midiNoteNumber) : false;
+        const bool bRootNoteOn = keyImage == KeyImageDownRoot;
         
         juce::Colour textColour(isDown ? (bRootNoteOn ? juce::Colours::red : juce::Colours::black) : juce::Colours::white);
         g.setColour (textColour);
@@ -141,6 +127,28 @@ void ScalesKeyboardComponent::drawBlackNote (int midiNoteNumber, juce::Graphics&
 void ScalesKeyboardComponent::drawWhiteNote (int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area,
                                              bool isDown, bool isOver, juce::Colour lineColour, juce::Colour textColour)
 {
+    UpdateKeyImageScale(g);
+    
+    const eKeyImage keyImage = GetKeyImageType(midiNoteNumber, isDown);
+    // One pixel of margin for the separator line drawn past the last key
+    const juce::Rectangle<int> imageArea = area.expanded(1.0f).getSmallestIntegerContainer();
+    juce::Image& image = m_keyImages[midiNoteNumber][keyImage];
+    
+    if(image.isNull())
+    {
+        image = CreateKeyImage(imageArea);
+        juce::Graphics imageGraphics(image);
+        imageGraphics.addTransform(GetKeyImageTransform(imageArea));
+        RenderWhiteNote(midiNoteNumber, imageGraphics, area, keyImage, lineColour);
+    }
+    
+    g.setOpacity(1.0f);
+    g.drawImage(image, imageArea.toFloat());
+}
+
+void ScalesKeyboardComponent::RenderWhiteNote(int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area, eKeyImage keyImage, juce::Colour lineColour)
+{
+    const bool isDown = keyImage != KeyImageUp;
     auto c = juce::Colours::transparentWhite;
     
     juce::Colour pressedColour = juce::Colours::lightblue;
@@ -149,8 +157,8 @@ void ScalesKeyboardComponent::drawWhiteNote (int midiNoteNumber, juce::Graphics&
     
     if (isDown)
     {
-        const bool bNoteActive = m_keyboardState.isNoteOn(KEYBOARD_UI_NOTE_CHANNEL, midiNoteNumber);
-        if(bNoteActive && !m_ScaleNotes.contains(midiNoteNumber % SCALES_OCTAVE_STEPS))
+        const bool bNoteActive = keyImage == KeyImageDownRoot;
+        if(bNoteActive && !IsNoteInScale(midiNoteNumber))
         {
             c = c.overlaidWith ( invalidColour );
         }
@@ -170,7 +178,7 @@ void ScalesKeyboardComponent::drawWhiteNote (int midiNoteNumber, juce::Graphics&
     if (text.isNotEmpty())
     {
         auto fontHeight = juce::jmin (16.0f, getKeyWidth() * 0.9f);
-        const bool bRootNoteOn = isDown ? m_keyboardState.isNoteOn(KEYBOARD_UI_NOTE_CHANNEL, midiNoteNumber) : false;
+        const bool bRootNoteOn = keyImage == KeyImageDownRoot;
         
         juce::Colour updatedTextColour(bRootNoteOn ? juce::Colours::red : juce::Colours::black);
         g.setColour (updatedTextColour);
@@ -210,28 +218,76 @@ void ScalesKeyboardComponent::drawWhiteNote (int midiNoteNumber, juce::Graphics&
     }
 }
 
-void ScalesKeyboardComponent::SetScale(int iRootNote, int iBaseNote, Scales::Type::eType eScaleType)
+void ScalesKeyboardComponent::SetScale(ScaleModel::Ptr pScaleModel)
+{
+    m_pScaleModel = pScaleModel;
+    
+    ClearKeyImages();
+    repaint();
+}
+
+bool ScalesKeyboardComponent::HasValidScale() const
+{
+    return m_pScaleModel != nullptr && m_pScaleModel->IsValid();
+}
+
+bool ScalesKeyboardComponent::IsNoteInScale(int midiNoteNumber) const
+{
+    return m_pScaleModel != nullptr && m_pScaleModel->Contains(midiNoteNumber);
+}
+
+void ScalesKeyboardComponent::resized()
+{
+    BaseKeyboardComponent::resized();
+    ClearKeyImages();
+}
+
+void ScalesKeyboardComponent::colourChanged()
+{
+    BaseKeyboardComponent::colourChanged();
+    ClearKeyImages();
+}
+
+ScalesKeyboardComponent::eKeyImage ScalesKeyboardComponent::GetKeyImageType(int midiNoteNumber, bool isDown) const
+{
+    if(!isDown)
+        return KeyImageUp;
+    
+    return m_keyboardState.isNoteOn(KEYBOARD_UI_NOTE_CHANNEL, midiNoteNumber) ? KeyImageDownRoot : KeyImageDown;
+}
+
+juce::Image ScalesKeyboardComponent::CreateKeyImage(juce::Rectangle<int> imageArea) const
 {
-    m_iScaleRootNote = iRootNote;
-    m_iScaleBaseNote = iBaseNote;
-    m_eScaleType = eScaleType;
+    const int iWidth = juce::jmax(1, juce::roundToInt(imageArea.getWidth() * m_fKeyImageScale));
+    const int iHeight = juce::jmax(1, juce::roundToInt(imageArea.getHeight() * m_fKeyImageScale));
     
-    Helpers::GetScaleSequence(m_eScaleType, m_ScaleNotes);
-    const int iNumNotes = m_ScaleNotes.size();
+    return juce::Image(juce::Image::ARGB, iWidth, iHeight, true);
+}
+
+juce::AffineTransform ScalesKeyboardComponent::GetKeyImageTransform(juce::Rectangle<int> imageArea) const
+{
+    // Key coordinates are relative to the keyboard, move them into the image and up to its pixel scale
+    return juce::AffineTransform::translation((float) -imageArea.getX(), (float) -imageArea.getY())
+                                 .followedBy(juce::AffineTransform::scale(m_fKeyImageScale));
+}
+
+void ScalesKeyboardComponent::UpdateKeyImageScale(juce::Graphics& g)
+{
+    // Dragging the window to a display with a different scale needs sharper (or smaller) images
+    const float fScale = g.getInternalContext().getPhysicalPixelScaleFactor();
     
-    if(m_iScaleRootNote >= 0)
+    if(fScale != m_fKeyImageScale)
     {
-        for(int i=0; i<iNumNotes; i++)
-        {
-            m_ScaleNotes.set(i, (m_ScaleNotes[i] + m_iScaleRootNote) % SCALES_OCTAVE_STEPS);
-        }
+        ClearKeyImages();
+        m_fKeyImageScale = fScale;
     }
-    
-    repaint();
 }
 
-bool ScalesKeyboardComponent::HasValidScale()
+void ScalesKeyboardComponent::ClearKeyImages()
 {
-    return m_iScaleBaseNote >= 0 && m_iScaleRootNote >= 0 && m_ScaleNotes.size() > 0;
+    for(auto& keyImages : m_keyImages)
+    {
+        for(auto& image : keyImages)
+            image = juce::Image();
+    }
 }
-
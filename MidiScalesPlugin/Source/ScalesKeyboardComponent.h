@@ -12,6 +12,7 @@
 
 #include "Utilities.h"
 #include "BaseKeyboardComponent.h"
+#include "ScaleModel.h"
 
 class ScalesKeyboardComponent : public BaseKeyboardComponent
 {
@@ -22,6 +23,7 @@ public:
     
     
     
+    // Labels are spelled by the ScaleModel, these only look them up
     virtual juce::String getWhiteNoteText (int midiNoteNumber) override;
     
     juce::String getBlackNoteText (int midiNoteNumber);
@@ -51,15 +53,41 @@ public:
                                 bool isDown, bool isOver,
                                 juce::Colour noteFillColour) override;
     
-    void SetScale(int iRootNote, int iBaseNote, Scales::Type::eType eScaleType);
+    // Shares the processor's scale, nothing about it is recalculated here
+    void SetScale(ScaleModel::Ptr pScaleModel);
+    ScaleModel::Ptr GetScale() const { return m_pScaleModel; }
     
-    bool HasValidScale();
+    bool HasValidScale() const;
+    
+    void resized() override;
+    void colourChanged() override;
     
 private:
+    bool IsNoteInScale(int midiNoteNumber) const;
+    
+    // Every key is rendered once per look into an image, painting only blits these.
+    // They are thrown away whenever the layout, colours or scale change.
+    enum eKeyImage
+    {
+        KeyImageUp = 0,
+        KeyImageDown,
+        KeyImageDownRoot,       // Down on the root note channel
+        KeyImageTotal
+    };
+    
+    eKeyImage GetKeyImageType(int midiNoteNumber, bool isDown) const;
+    // Blank image covering imageArea at the display's pixel scale, and the transform to render the key into it
+    juce::Image CreateKeyImage(juce::Rectangle<int> imageArea) const;
+    juce::AffineTransform GetKeyImageTransform(juce::Rectangle<int> imageArea) const;
+    void UpdateKeyImageScale(juce::Graphics& g);
+    void ClearKeyImages();
+    
+    void RenderWhiteNote(int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area, eKeyImage keyImage, juce::Colour lineColour);
+    void RenderBlackNote(int midiNoteNumber, juce::Graphics& g, juce::Rectangle<float> area, eKeyImage keyImage, juce::Colour noteFillColour);
+    
     const juce::MidiKeyboardState& m_keyboardState;
-    ScaleNotes m_ScaleNotes;
-    int m_iScaleBaseNote;
-    int m_iScaleRootNote;
-
-    Scales::Type::eType m_eScaleType;
+    ScaleModel::Ptr m_pScaleModel;
+    
+    juce::Image m_keyImages[SCALES_TOTAL_STEPS][KeyImageTotal];
+    float m_fKeyImageScale;
 };
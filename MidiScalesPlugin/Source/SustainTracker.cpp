@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    SustainTracker.cpp
+    Created: 17 Oct 2026 11:57:58pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#include "SustainTracker.h"
+
+SustainTracker::SustainTracker()
+{
+    Reset();
+}
+
+SustainTracker::~SustainTracker()
+{
+}
+
+void SustainTracker::Reset()
+{
+    std::memset(m_latchedNotes, 0, sizeof(m_latchedNotes));
+    m_uPedalDownChannels = 0;
+}
+
+bool SustainTracker::IsPedalDown(int iChannel) const
+{
+    return IsValidChannel(iChannel) && ((m_uPedalDownChannels >> (iChannel - 1)) & 1) != 0;
+}
+
+void SustainTracker::SetPedalDown(int iChannel, bool bDown)
+{
+    if(!IsValidChannel(iChannel))
+        return;
+    
+    if(bDown)
+        m_uPedalDownChannels |= 1u << (iChannel - 1);
+    else
+        m_uPedalDownChannels &= ~(1u << (iChannel - 1));
+}
+
+void SustainTracker::Latch(int iChannel, int iNote)
+{
+    if(IsValidChannel(iChannel) && iNote >= 0 && iNote < SCALES_TOTAL_STEPS)
+        m_latchedNotes[iChannel - 1][iNote / 64] |= (juce::uint64) 1 << (iNote % 64);
+}
+
+void SustainTracker::Unlatch(int iChannel, int iNote)
+{
+    if(IsValidChannel(iChannel) && iNote >= 0 && iNote < SCALES_TOTAL_STEPS)
+        m_latchedNotes[iChannel - 1][iNote / 64] &= ~((juce::uint64) 1 << (iNote % 64));
+}
+
+int SustainTracker::TakeLatched(int iChannel, juce::uint8* pNotes)
+{
+    if(!IsValidChannel(iChannel))
+        return 0;
+    
+    int iNumNotes = 0;
+    
+    for(int iWord = 0; iWord < SCALES_TOTAL_STEPS / 64; iWord++)
+    {
+        juce::uint64 uLatched = m_latchedNotes[iChannel - 1][iWord];
+        m_latchedNotes[iChannel - 1][iWord] = 0;
+        
+        // Only visits the set bits
+        while(uLatched != 0)
+        {
+            // uLatched ^ (uLatched - 1) is the lowest set bit and every bit below it
+            const int iBit = juce::countNumberOfBits(uLatched ^ (uLatched - 1)) - 1;
+            uLatched &= uLatched - 1;
+            pNotes[iNumNotes++] = (juce::uint8) (iWord * 64 + iBit);
+        }
+    }
+    
+    return iNumNotes;
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    SustainTracker.h
+    Created: 17 Oct 2026 11:57:41pm
+    Author:  Maaz
+
+  ==============================================================================
+*/
+
+#pragma once
+#include "Utilities.h"
+
+// Sustain pedal state per input channel, and the keys released while it was down whose
+// chords keep sounding until pedal-up. One bit per key and channel, so latching a key is
+// O(1) however many are latched, and pedal-up collects them all in one pass over 128 bits.
+class SustainTracker
+{
+public:
+    SustainTracker();
+    ~SustainTracker();
+    
+    // Pedals up, nothing latched
+    void Reset();
+    
+    bool IsPedalDown(int iChannel) const;
+    void SetPedalDown(int iChannel, bool bDown);
+    
+    // Key released with the pedal down, its chord is ended on pedal-up
+    void Latch(int iChannel, int iNote);
+    // Key played again, it holds its chord itself
+    void Unlatch(int iChannel, int iNote);
+    
+    // Fills pNotes (room for SCALES_TOTAL_STEPS) with the channel's latched keys, lowest first,
+    // and forgets them. Returns the number of keys.
+    int TakeLatched(int iChannel, juce::uint8* pNotes);
+    
+private:
+    static bool IsValidChannel(int iChannel) { return iChannel >= 1 && iChannel <= MIDI_CHANNELS; }
+    
+    // Bit N of word N / 64 is note N
+    juce::uint64 m_latchedNotes[MIDI_CHANNELS][SCALES_TOTAL_STEPS / 64];
+    // Bit N is channel N + 1
+    juce::uint32 m_uPedalDownChannels;
+    
+    JUCE_DECLARE_NON_COPYABLE (SustainTracker)
+};
@@ -9,71 +9,28 @@
 */
 
 #include "Utilities.h"
+#include "ScaleLibrary.h"
 
 namespace Helpers
 {
-    // Hard code scales in integer notation. Should come from data in future!
-    void GetScaleSequence(Scales::Type::eType scaleType, ScaleNotes& scaleComposition)
+    const ScaleNotes& GetScaleSequence(Scales::Type::eType scaleType)
     {
-        scaleComposition.clearQuick();
-        switch (scaleType)
-        {
-            case Scales::Type::Major:
-            {
-                scaleComposition.add(0, 2, 4, 5, 7, 9, 11);
-            }
-                break;
-            case Scales::Type::NaturalMinor:
-            {
-                scaleComposition.add(0, 2, 3, 5, 7, 8, 10);
-            }
-                break;
-            case Scales::Type::HarmonicMinor:
-            {
-                scaleComposition.add(0, 2, 3, 5, 7, 8, 11);
-            }
-                break;
-            case Scales::Type::MelodicMinor:
-            {
-                scaleComposition.add(0, 2, 3, 5, 7, 9 ,11);
-            }
-                break;
-            default:
-                break;
-                //Do Nothing
-        }
+        return ScaleLibrary::GetInstance().GetScale(scaleType);
     }
     
-    // Hard code chords in integer notation. Should come from data in future!
-    void GetChordSequence(Chords::Type::eType chordType, ChordNotes& chordComposition)
+    const ChordNotes& GetChordSequence(Chords::Type::eType chordType)
     {
-        chordComposition.clearQuick();
-        switch (chordType)
-        {
-            case Chords::Type::MajorTriad:
-            {
-                chordComposition.add(0, 4, 7);
-            }
-                break;
-            case Chords::Type::MinorTriad:
-            {
-                chordComposition.add(0, 3, 7);
-            }
-                break;
-            case Chords::Type::MajorSeventh:
-            {
-                chordComposition.add(0, 4, 7, 11);
-            }
-                break;
-            case Chords::Type::MinorSeventh:
-            {
-                chordComposition.add(0, 3, 7, 10);
-            }
-                break;
-            default:
-                break;
-                //Do Nothing
-        }
+        return ScaleLibrary::GetInstance().GetChord(chordType);
+    }
+    
+    ScaleMask GetScaleMask(Scales::Type::eType scaleType, int iScaleNote)
+    {
+        // Rotate the interval mask up to the scale's root note
+        const juce::uint32 uIntervalMask = GetScaleSequence(scaleType).mask;
+        const int iRotation = juce::jmax(iScaleNote, 0) % SCALES_OCTAVE_STEPS;
+        const juce::uint32 uOctaveMask = (1u << SCALES_OCTAVE_STEPS) - 1;
+        
+        return (ScaleMask) (((uIntervalMask << iRotation) | (uIntervalMask >> (SCALES_OCTAVE_STEPS - iRotation))) & uOctaveMask);
     }
     
     int GetNoteNumber(Notes::Type::eType eType)
@@ -82,42 +39,85 @@ namespace Helpers
         return s_noteIndices[eType];
     }
     
-    // TODO: These names should come from data
     juce::String GetScaleTypeString(Scales::Type::eType scaleType)
     {
-        switch (scaleType)
-        {
-            case Scales::Type::Major:
-                return "Major/Ionian";
-            case Scales::Type::NaturalMinor:
-                return "Natural Minor";
-            case Scales::Type::HarmonicMinor:
-                return "Harmonic Minor";
-            case Scales::Type::MelodicMinor:
-                return "Melodic Minor";
-            default:
-                return "Invalid";
-                //Do Nothing
-        }
+        return juce::String::fromUTF8(ScaleLibrary::GetInstance().GetScaleName(scaleType));
     }
     
-    // TODO: These names should come from data
     juce::String GetChordTypeString(Chords::Type::eType chordType)
     {
-        switch (chordType)
-        {
-            case Chords::Type::MajorTriad:
-                return "Major Triad";
-            case Chords::Type::MinorTriad:
-                return "Minor Triad";
-            case Chords::Type::MajorSeventh:
-                return "Major Seventh";
-            case Chords::Type::MinorSeventh:
-                return "Minor Seventh";
-            default:
-                return "Invalid";
-                //Do Nothing
-        }
+        return juce::String::fromUTF8(ScaleLibrary::GetInstance().GetChordName(chordType));
+    }
+    
+    juce::String GetQuantizeModeString(Quantize::Mode::eMode quantizeMode)
+    {
+        const static char* s_quantizeModeText[] = {"Off", "Nearest", "Up", "Down", "Degree"};
+        static_assert(sizeof(s_quantizeModeText) / sizeof(s_quantizeModeText[0]) == Quantize::Mode::Total, "One name per quantize mode");
+        
+        return quantizeMode >= 0 && quantizeMode < Quantize::Mode::Total ? s_quantizeModeText[quantizeMode] : "";
+    }
+    
+    juce::String GetVoicingModeString(Voicing::Mode::eMode voicingMode)
+    {
+        const static char* s_voicingModeText[] = {"Root Position", "Voice Leading"};
+        static_assert(sizeof(s_voicingModeText) / sizeof(s_voicingModeText[0]) == Voicing::Mode::Total, "One name per voicing mode");
+        
+        return voicingMode >= 0 && voicingMode < Voicing::Mode::Total ? s_voicingModeText[voicingMode] : "";
+    }
+    
+    juce::String GetStrumDirectionString(Strum::Direction::eDirection strumDirection)
+    {
+        const static char* s_strumDirectionText[] = {"Up", "Down", "Alternate"};
+        static_assert(sizeof(s_strumDirectionText) / sizeof(s_strumDirectionText[0]) == Strum::Direction::Total, "One name per strum direction");
+        
+        return strumDirection >= 0 && strumDirection < Strum::Direction::Total ? s_strumDirectionText[strumDirection] : "";
+    }
+    
+    juce::String GetArpPatternString(Arpeggio::Pattern::ePattern arpPattern)
+    {
+        const static char* s_arpPatternText[] = {"Up", "Down", "Up-Down", "Random", "As Played"};
+        static_assert(sizeof(s_arpPatternText) / sizeof(s_arpPatternText[0]) == Arpeggio::Pattern::Total, "One name per arpeggio pattern");
+        
+        return arpPattern >= 0 && arpPattern < Arpeggio::Pattern::Total ? s_arpPatternText[arpPattern] : "";
+    }
+    
+    juce::String GetArpRateString(Arpeggio::Rate::eRate arpRate)
+    {
+        const static char* s_arpRateText[] = {"1/4", "1/8", "1/8T", "1/16", "1/16T", "1/32"};
+        static_assert(sizeof(s_arpRateText) / sizeof(s_arpRateText[0]) == Arpeggio::Rate::Total, "One name per arpeggio rate");
+        
+        return arpRate >= 0 && arpRate < Arpeggio::Rate::Total ? s_arpRateText[arpRate] : "";
+    }
+    
+    double GetArpRateQuarterNotes(Arpeggio::Rate::eRate arpRate)
+    {
+        const static double s_arpRateQuarterNotes[] = {1.0, 1.0 / 2.0, 1.0 / 3.0, 1.0 / 4.0, 1.0 / 6.0, 1.0 / 8.0};
+        static_assert(sizeof(s_arpRateQuarterNotes) / sizeof(s_arpRateQuarterNotes[0]) == Arpeggio::Rate::Total, "One length per arpeggio rate");
+        
+        return arpRate >= 0 && arpRate < Arpeggio::Rate::Total ? s_arpRateQuarterNotes[arpRate] : 1.0;
+    }
+    
+    int GetStateFieldVersion(PluginState::Byte::eByte field)
+    {
+        // The first field of every version, see PluginState::Byte
+        if(field >= PluginState::Byte::Sharps)
+            return 9;
+        if(field >= PluginState::Byte::Mpe)
+            return 8;
+        if(field >= PluginState::Byte::Arpeggiator)
+            return 7;
+        if(field >= PluginState::Byte::StrumMs)
+            return 6;
+        if(field >= PluginState::Byte::VoicingMode)
+            return 5;
+        if(field >= PluginState::Byte::DiatonicChords)
+            return 4;
+        if(field >= PluginState::Byte::QuantizeMode)
+            return 3;
+        if(field >= PluginState::Byte::ScaleTypeHigh)
+            return 2;
+        
+        return 1;
     }
     
     juce::String GetNoteString(Notes::Type::eType noteType)
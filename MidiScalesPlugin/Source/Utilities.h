@@ -13,7 +13,9 @@
 #include <JuceHeader.h>
 #include <array>
 
-#define CHORD_MAX_NOTES 5
+#define CHORD_MAX_NOTES 7
+#define CHORD_MAX_VOICES 16
+#define MIDI_CHANNELS 16
 #define SCALES_OCTAVE_STEPS 12
 
 #define SCALES_OCTAVE_STEPS_RANGE 25
@@ -21,17 +23,111 @@
 #define SCALES_OCTAVE_NORMALIZED_START 0
 #define SCALES_TOTAL_STEPS 128
 
+// MidiBuffer storage per note message: int32 sample position + uint16 size + 3 data bytes
+#define MIDI_BUFFER_NOTE_EVENT_BYTES (sizeof(juce::int32) + sizeof(juce::uint16) + 3)
+// Scratch MIDI buffers reserve for at least this many incoming events per block
+#define MIDI_MIN_RESERVED_INPUT_EVENTS 1024
+
+// Default register voice leading keeps chord notes in, the octave below middle C to two above it,
+// and the narrowest register the editor allows
+#define VOICING_DEFAULT_LOW_NOTE 48
+#define VOICING_DEFAULT_HIGH_NOTE 84
+#define VOICING_MIN_REGISTER_STEPS 12
+
+// Strum limits: delay between consecutive chord notes, the most humanize moves a note later and
+// scales its velocity by (+-), and how many input events the scheduler keeps room for while a
+// strum window (the longest a chord can take to sound all its notes) is still pending
+#define STRUM_MAX_NOTE_MS 50
+#define STRUM_MAX_HUMANIZE_MS 20
+#define STRUM_MAX_HUMANIZE_VELOCITY 0.2f
+#define STRUM_MAX_WINDOW_INPUT_EVENTS 4096
+
+// Arpeggiator tempo when the host doesn't report one (or there is no host), the fastest tempo
+// it plans buffer space for, and the default gate in percent of a step
+#define ARPEGGIATOR_DEFAULT_BPM 120.0
+#define ARPEGGIATOR_MAX_BPM 999.0
+#define ARPEGGIATOR_DEFAULT_GATE 50
+
+// MPE lower zone: zone-wide messages on the master channel, one note at a time on each member
+// channel. Timbre is CC 74. Every chord started from an MPE controller gets pitch bend, channel
+// pressure and timbre on each of its tones' channels before its notes start.
+#define MPE_MASTER_CHANNEL 1
+#define MPE_FIRST_MEMBER_CHANNEL 2
+#define MPE_LAST_MEMBER_CHANNEL 16
+#define MPE_TIMBRE_CONTROLLER 74
+#define MPE_NOTE_EXPRESSION_MESSAGES 3
+
+// Sustain pedal, down from a value of 64. Chords released while it is down sound until it comes up.
+#define SUSTAIN_PEDAL_CONTROLLER 64
+#define SUSTAIN_PEDAL_DOWN_VALUE 64
+
 #define KEYBOARD_UI_CHORD_CHANNEL 1
 #define KEYBOARD_UI_NOTE_CHANNEL 2
 
-typedef juce::Array<int> ChordNotes;
-typedef juce::Array<int> ScaleNotes;
+// Note changes the audio thread can queue for the on-screen keyboard between two
+// editor refreshes, and how often the editor applies them
+#define KEYBOARD_STATE_FIFO_SIZE 4096
+#define KEYBOARD_UI_REFRESH_HZ 30
+
+// Blocks the audio thread can queue before the stats reader collects them,
+// and how many of the most recent blocks the reader summarises
+#define PROCESSING_STATS_FIFO_SIZE 1024
+#define PROCESSING_STATS_HISTORY_SIZE 2048
+
+// Plugin state blob: PLUGIN_STATE_MAGIC, PLUGIN_STATE_VERSION, then one byte per PluginState::Byte field.
+// New fields are only ever appended (bumping the version), so older sessions simply end early and
+// their missing fields keep the defaults, while unknown trailing bytes from newer sessions are ignored.
+// A field is only read from blobs at least as new as the version that added it.
+#define PLUGIN_STATE_MAGIC 0x4D
+#define PLUGIN_STATE_VERSION 9
+
+// Bit N set -> pitch class N (C = 0) is part of the scale
+typedef juce::uint16 ScaleMask;
 
+// Fixed size set of intervals in semitones above a root note, in ascending order.
+// Built at compile time so lookups never touch the heap. Also the record layout of
+// the scale library pack (see ScaleLibraryFormat.h), so only fixed width members.
+template <int MaxSteps>
+struct IntervalSet
+{
+    juce::uint32 mask;      // Bit N set -> N semitones above the root is in the set
+    juce::int32 numSteps;
+    juce::uint8 steps[MaxSteps];
+    
+    int size() const { return numSteps; }
+    int operator[](int i) const { return steps[i]; }
+    const juce::uint8* begin() const { return steps; }
+    const juce::uint8* end() const { return steps + numSteps; }
+    
+    bool Contains(int iStep) const { return iStep >= 0 && iStep < 32 && ((mask >> iStep) & 1); }
+    // Position of the step in the set (the scale degree for scales), -1 if it isn't part of it
+    int IndexOf(int iStep) const { return Contains(iStep) ? juce::countNumberOfBits(mask & ((1u << iStep) - 1)) : -1; }
+};
+
+template <int MaxSteps>
+constexpr IntervalSet<MaxSteps> MakeIntervalSet(std::initializer_list<int> steps)
+{
+    IntervalSet<MaxSteps> intervalSet { 0, 0, {} };
+    
+    for(int iStep : steps)
+    {
+        intervalSet.mask |= 1u << iStep;
+        intervalSet.steps[intervalSet.numSteps++] = (juce::uint8) iStep;
+    }
+    
+    return intervalSet;
+}
+
+typedef IntervalSet<CHORD_MAX_NOTES> ChordNotes;
+typedef IntervalSet<SCALES_OCTAVE_STEPS> ScaleNotes;
+
+// Type values are stored in the plugin state, never renumber them, only append
 namespace Chords
 {
     namespace Type
     {
-        enum eType
+        // Built-in types, the scale library adds more IDs after Total
+        enum eType : int
         {
             Invalid = 0,
             MajorTriad,
@@ -47,7 +143,8 @@ namespace Scales
 {
     namespace Type
     {
-        enum eType
+        // Built-in types, the scale library adds more IDs after Total
+        enum eType : int
         {
             Invalid = 0,
             Major,
@@ -59,6 +156,117 @@ namespace Scales
     };
 };
 
+// Stored in the plugin state, never renumber, only append
+namespace Quantize
+{
+    namespace Mode
+    {
+        enum eMode
+        {
+            Off = 0,        // Notes outside the scale aren't played
+            Nearest,        // Ties snap down
+            Up,
+            Down,
+            Degree,         // White keys play the scale degrees in order, the root on middle C, black keys repeat the white key below
+            Total
+        };
+    };
+};
+
+// Stored in the plugin state, never renumber, only append
+namespace Voicing
+{
+    namespace Mode
+    {
+        enum eMode
+        {
+            RootPosition = 0,   // As the chord is written, on the pressed note
+            VoiceLeading,       // Inversion and octave closest to the previous chord, inside the voicing register
+            Total
+        };
+    };
+};
+
+// Stored in the plugin state, never renumber, only append
+namespace Strum
+{
+    namespace Direction
+    {
+        enum eDirection
+        {
+            Up = 0,         // Lowest note first
+            Down,
+            Alternate,      // Up and down on every other chord
+            Total
+        };
+    };
+};
+
+// Stored in the plugin state, never renumber, only append
+namespace Arpeggio
+{
+    namespace Pattern
+    {
+        enum ePattern
+        {
+            Up = 0,
+            Down,
+            UpDown,         // Top and bottom notes are only played once per cycle
+            Random,
+            AsPlayed,       // Order the chord notes started in
+            Total
+        };
+    };
+    
+    // Step length
+    namespace Rate
+    {
+        enum eRate
+        {
+            Quarter = 0,
+            Eighth,
+            EighthTriplet,
+            Sixteenth,
+            SixteenthTriplet,
+            ThirtySecond,
+            Total
+        };
+    };
+};
+
+namespace PluginState
+{
+    namespace Byte
+    {
+        enum eByte
+        {
+            Magic = 0,
+            Version,
+            ScaleNote,
+            ScaleType,
+            ChordType,
+            ScaleTypeHigh,      // Version 2: library IDs go past 255
+            ChordTypeHigh,
+            QuantizeMode,       // Version 3
+            DiatonicChords,     // Version 4
+            VoicingMode,        // Version 5
+            VoicingLowNote,
+            VoicingHighNote,
+            StrumMs,            // Version 6
+            StrumDirection,
+            StrumVelocityCurve, // Percent + 100
+            Humanize,           // Percent
+            Arpeggiator,        // Version 7
+            ArpPattern,
+            ArpRate,
+            ArpGate,            // Percent
+            Mpe,                // Version 8
+            Sharps,             // Version 9
+            Total
+        };
+    };
+};
+
 namespace Notes
 {
     namespace Type
@@ -79,12 +287,22 @@ namespace Notes
 
 namespace Helpers
 {
-    void GetScaleSequence(Scales::Type::eType scaleType, ScaleNotes& scaleComposition);
-    void GetChordSequence(Chords::Type::eType chordType, ChordNotes& chordComposition);
+    const ScaleNotes& GetScaleSequence(Scales::Type::eType scaleType);
+    const ChordNotes& GetChordSequence(Chords::Type::eType chordType);
+    ScaleMask GetScaleMask(Scales::Type::eType scaleType, int iScaleNote);
     int GetNoteNumber(Notes::Type::eType);
     
     juce::String GetScaleTypeString(Scales::Type::eType scaleType);
     juce::String GetChordTypeString(Chords::Type::eType chordType);
+    juce::String GetQuantizeModeString(Quantize::Mode::eMode quantizeMode);
+    juce::String GetVoicingModeString(Voicing::Mode::eMode voicingMode);
+    juce::String GetStrumDirectionString(Strum::Direction::eDirection strumDirection);
+    juce::String GetArpPatternString(Arpeggio::Pattern::ePattern arpPattern);
+    juce::String GetArpRateString(Arpeggio::Rate::eRate arpRate);
+    // Length of one step in quarter notes
+    double GetArpRateQuarterNotes(Arpeggio::Rate::eRate arpRate);
+    // Plugin state version that added the field
+    int GetStateFieldVersion(PluginState::Byte::eByte field);
     juce::String GetNoteString(Notes::Type::eType noteType);
     int GetNoteType(const char* note);
 }